@@ -0,0 +1,76 @@
+package macho
+
+import "sort"
+
+// addrRange is the half open range [start, end) covered by the segment or section at idx
+type addrRange struct {
+	start uint64
+	end   uint64
+	idx   int
+}
+
+// rangeTable is a set of non-overlapping addrRanges sorted by start
+type rangeTable []addrRange
+
+// newRangeTable sorts ranges and returns nil if any of them overlap (or wrap) in which
+// case lookups must fall back to a scan to keep first-match-in-load-order semantics
+func newRangeTable(ranges []addrRange) rangeTable {
+	sort.Slice(ranges, func(i, j int) bool { return ranges[i].start < ranges[j].start })
+	for i, r := range ranges {
+		if r.end < r.start || (i > 0 && r.start < ranges[i-1].end) {
+			return nil
+		}
+	}
+	return ranges
+}
+
+// find returns the index of the range containing v or -1
+func (t rangeTable) find(v uint64) int {
+	i := sort.Search(len(t), func(i int) bool { return t[i].end > v })
+	if i < len(t) && t[i].start <= v {
+		return t[i].idx
+	}
+	return -1
+}
+
+// addrIndex caches the segment/section tables used for vmaddr <-> offset translation.
+// The tables are a snapshot of the Addr/Offset/size fields: lookups only trust a hit that the
+// live Segment or Section still covers and otherwise scan the loads, so edits to these fields stay
+// correct but are slow until the index is rebuilt (Export does that itself).
+type addrIndex struct {
+	segs     []*Segment
+	segAddrs rangeTable // segment vm ranges (Addr, Memsz)
+	segOffs  rangeTable // segment file ranges (Offset, Filesz)
+	secAddrs rangeTable // section vm ranges (Addr, Size)
+}
+
+func newAddrIndex(t *FileTOC) *addrIndex {
+	idx := new(addrIndex)
+	var addrs, offs []addrRange
+	for _, l := range t.Loads {
+		if s, ok := l.(*Segment); ok {
+			if s.Memsz > 0 {
+				addrs = append(addrs, addrRange{s.Addr, s.Addr + s.Memsz, len(idx.segs)})
+			}
+			if s.Filesz > 0 {
+				offs = append(offs, addrRange{s.Offset, s.Offset + s.Filesz, len(idx.segs)})
+			}
+			idx.segs = append(idx.segs, s)
+		}
+	}
+	idx.segAddrs = newRangeTable(addrs)
+	idx.segOffs = newRangeTable(offs)
+	var secs []addrRange
+	for i, sec := range t.Sections {
+		if sec.Size > 0 {
+			secs = append(secs, addrRange{sec.Addr, sec.Addr + sec.Size, i})
+		}
+	}
+	idx.secAddrs = newRangeTable(secs)
+	return idx
+}
+
+// buildAddrIndex (re)builds the cached address tables; AddLoad and AddSection drop them
+func (t *FileTOC) buildAddrIndex() {
+	t.addrs = newAddrIndex(t)
+}
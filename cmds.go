@@ -184,7 +184,13 @@ func (s *Segment) Write(buf *bytes.Buffer, o binary.ByteOrder) error {
 }
 
 // Data reads and returns the contents of the segment.
+// If the File was opened with OpenMmap the returned slice is a read-only view into the mapping.
 func (s *Segment) Data() ([]byte, error) {
+	if mr, ok := s.ReaderAt.(*mmapReader); ok {
+		if dat, err := mr.Slice(int64(s.Offset), s.Filesz); err == nil {
+			return dat, nil
+		}
+	}
 	dat := make([]byte, s.Filesz)
 	n, err := s.ReadAt(dat, int64(s.Offset))
 	if n == len(dat) {
@@ -283,10 +289,26 @@ type Section struct {
 	// with other clients.
 	io.ReaderAt
 	sr *io.SectionReader
+
+	parseRelocs func() error // decodes the relocations deferred by FileConfig.LazyLoad
+}
+
+// ParseRelocs decodes Relocs if the File was opened with FileConfig.LazyLoad (see File.ParseRelocs)
+func (s *Section) ParseRelocs() error {
+	if s.parseRelocs == nil {
+		return nil
+	}
+	return s.parseRelocs()
 }
 
 // Data reads and returns the contents of the Mach-O section.
+// If the File was opened with OpenMmap the returned slice is a read-only view into the mapping.
 func (s *Section) Data() ([]byte, error) {
+	if mr, ok := s.ReaderAt.(*mmapReader); ok {
+		if dat, err := mr.Slice(int64(s.Offset), s.Size); err == nil {
+			return dat, nil
+		}
+	}
 	dat := make([]byte, s.Size)
 	n, err := s.ReadAt(dat, int64(s.Offset))
 	if n == len(dat) {
@@ -372,7 +394,12 @@ func (s *Section) Write(buf *bytes.Buffer, o binary.ByteOrder) error {
 	return nil
 }
 
+// PutRelocs writes the relocations of s to b, decoding them first if they were deferred by
+// FileConfig.LazyLoad. It panics if they can't be decoded as Put has no way to return the error.
 func (s *Section) PutRelocs(b []byte, o binary.ByteOrder) int {
+	if err := s.ParseRelocs(); err != nil {
+		panic(fmt.Sprintf("failed to decode the relocations of section %s.%s: %v", s.Seg, s.Name, err))
+	}
 	a := 0
 	for _, r := range s.Relocs {
 		var ri relocInfo
@@ -478,6 +505,8 @@ type Symtab struct {
 	LoadBytes
 	types.SymtabCmd
 	Syms []Symbol
+
+	strtab string // string table arena that every Symbol.Name is a view into
 }
 
 func (s *Symtab) String() string {
@@ -487,7 +516,16 @@ func (s *Symtab) String() string {
 	return fmt.Sprintf("Symbol offset=0x%08X, Num Syms: %d, String offset=0x%08X-0x%08X", s.Symoff, s.Nsyms, s.Stroff, s.Stroff+s.Strsize)
 }
 func (s *Symtab) Copy() *Symtab {
-	return &Symtab{SymtabCmd: s.SymtabCmd, Syms: append([]Symbol{}, s.Syms...)}
+	return &Symtab{SymtabCmd: s.SymtabCmd, Syms: append([]Symbol{}, s.Syms...), strtab: s.strtab}
+}
+
+// StringAt returns the NUL terminated string at offset off in the string table.
+// The result shares memory with the table so no allocation is made.
+func (s *Symtab) StringAt(off uint32) (string, error) {
+	if off >= uint32(len(s.strtab)) {
+		return "", fmt.Errorf("string table offset %#x out of range", off)
+	}
+	return cstringAt(s.strtab, off), nil
 }
 func (s *Symtab) LoadSize(t *FileTOC) uint32 {
 	return uint32(unsafe.Sizeof(types.SymtabCmd{}))
@@ -0,0 +1,124 @@
+package macho
+
+import (
+	"bytes"
+	"fmt"
+	"sort"
+	"strings"
+	"sync"
+)
+
+// cstringCache holds the GetCStringAtOffset cache and the tables built by IndexCStrings
+type cstringCache struct {
+	sync.RWMutex
+	strs map[int64]string // file offset -> string
+	tabs []cstringTable   // sorted by offset
+}
+
+// cstringSections are the sections IndexCStrings slices into string tables
+var cstringSections = []string{
+	"__cstring",
+	"__objc_methname",
+	"__objc_classname",
+	"__objc_methtype",
+}
+
+// cstringTable is a C-string section copied once into a single string
+type cstringTable struct {
+	off  int64 // file offset of the section
+	data string
+}
+
+// lookup returns the NUL terminated string at file offset off as a view into the table
+func (t *cstringTable) lookup(off int64) (string, bool) {
+	s := t.data[off-t.off:]
+	if i := strings.IndexByte(s, 0); i >= 0 {
+		return s[:i], true
+	}
+	return "", false // unterminated; let the caller read past the section
+}
+
+// IndexCStrings slices the __cstring, __objc_methname, __objc_classname and __objc_methtype
+// sections once into string tables. Afterwards GetCString and GetCStringAtOffset answer
+// lookups into those sections with a slice of the table instead of reading the file.
+func (f *File) IndexCStrings() error {
+	var tabs []cstringTable
+	for _, sec := range f.Sections {
+		for _, name := range cstringSections {
+			if sec.Name != name || sec.Size == 0 {
+				continue
+			}
+			dat, err := sec.Data()
+			if err != nil {
+				return fmt.Errorf("failed to read %s.%s data: %v", sec.Seg, sec.Name, err)
+			}
+			tabs = append(tabs, cstringTable{off: int64(sec.Offset), data: string(dat)})
+		}
+	}
+	sort.Slice(tabs, func(i, j int) bool { return tabs[i].off < tabs[j].off })
+
+	f.cstrs.Lock()
+	f.cstrs.tabs = tabs
+	f.cstrs.Unlock()
+	return nil
+}
+
+// cachedCString returns the string at off if it was read before or falls inside a table built by IndexCStrings
+func (f *File) cachedCString(off int64) (string, bool) {
+	f.cstrs.RLock()
+	defer f.cstrs.RUnlock()
+
+	if s, ok := f.cstrs.strs[off]; ok {
+		return s, true
+	}
+
+	tabs := f.cstrs.tabs
+	i := sort.Search(len(tabs), func(i int) bool {
+		return tabs[i].off+int64(len(tabs[i].data)) > off
+	})
+	if i < len(tabs) && tabs[i].off <= off {
+		return tabs[i].lookup(off)
+	}
+	return "", false
+}
+
+// cacheCString remembers the string read at off
+func (f *File) cacheCString(off int64, s string) {
+	f.cstrs.Lock()
+	if f.cstrs.strs == nil {
+		f.cstrs.strs = make(map[int64]string)
+	}
+	f.cstrs.strs[off] = s
+	f.cstrs.Unlock()
+}
+
+// readCString reads the NUL terminated string at off from the file
+func (f *File) readCString(off int64) (string, error) {
+	if f.mr != nil {
+		if off >= int64(len(f.mr.data)) {
+			return "", fmt.Errorf("failed to read cstring at offset 0x%x: out of range", off)
+		}
+		dat := f.mr.data[off:]
+		if i := bytes.IndexByte(dat, 0); i >= 0 {
+			return string(dat[:i]), nil
+		}
+		return "", fmt.Errorf("failed to read cstring at offset 0x%x: no NUL terminator", off)
+	}
+
+	var buf [128]byte
+	var str []byte
+	for {
+		n, err := f.sr.ReadAt(buf[:], off)
+		if i := bytes.IndexByte(buf[:n], 0); i >= 0 {
+			if str == nil {
+				return string(buf[:i]), nil
+			}
+			return string(append(str, buf[:i]...)), nil
+		}
+		if err != nil {
+			return "", fmt.Errorf("failed to read cstring at offset 0x%x: %v", off, err)
+		}
+		str = append(str, buf[:n]...)
+		off += int64(n)
+	}
+}
@@ -9,6 +9,7 @@ import (
 	"fmt"
 	"io"
 	"os"
+	"sync"
 
 	"github.com/blacktop/go-macho/types"
 )
@@ -32,20 +33,74 @@ type FatArchHeader struct {
 const fatArchHeaderSize = 5 * 4
 
 // A FatArch is a Mach-O File inside a FatFile.
+// With FatFileConfig.LazyArches the embedded File is nil; use Open to parse it.
 type FatArch struct {
 	FatArchHeader
 	*File
+
+	lazy *fatArchLoader
+}
+
+// fatArchLoader parses a lazy FatArch on first Open
+type fatArchLoader struct {
+	once   sync.Once
+	r      io.ReaderAt
+	config FileConfig
+	file   *File
+	err    error
+}
+
+// FatFileConfig configures NewFatFile and OpenFat
+type FatFileConfig struct {
+	// LazyArches only reads the fat_arch headers up front; each architecture is parsed by FatArch.Open
+	LazyArches bool
+	// Parallel parses all the architectures concurrently (ignored with LazyArches)
+	Parallel bool
+	// FileConfig is passed to NewFile for every architecture (Offset and SrcReader are ignored)
+	FileConfig FileConfig
+}
+
+// Open returns the Mach-O File of the architecture, parsing it on first use if the FatFile was opened with LazyArches.
+// It is safe to call from multiple goroutines.
+func (fa *FatArch) Open() (*File, error) {
+	if fa.File != nil || fa.lazy == nil {
+		return fa.File, nil
+	}
+	fa.lazy.once.Do(func() {
+		fa.lazy.file, fa.lazy.err = NewFile(io.NewSectionReader(fa.lazy.r, int64(fa.Offset), int64(fa.Size)), fa.lazy.config)
+	})
+	return fa.lazy.file, fa.lazy.err
 }
 
 // ErrNotFat is returned from NewFatFile or OpenFat when the file is not a
 // universal binary but may be a thin binary, based on its magic number.
 var ErrNotFat = &FormatError{0, "not a fat Mach-O file", nil}
 
+// peekFileType reads the file type from the Mach-O header at off without parsing the file
+func peekFileType(r io.ReaderAt, off int64) (types.HeaderFileType, error) {
+	var hdr [16]byte
+	if _, err := r.ReadAt(hdr[:], off); err != nil {
+		return 0, err
+	}
+	var bo binary.ByteOrder = binary.LittleEndian
+	if be := binary.BigEndian.Uint32(hdr[:]); be&^1 == types.Magic32.Int()&^1 {
+		bo = binary.BigEndian
+	}
+	return types.HeaderFileType(bo.Uint32(hdr[12:])), nil
+}
+
 // NewFatFile creates a new FatFile for accessing all the Mach-O images in a
 // universal binary. The Mach-O binary is expected to start at position 0 in
 // the ReaderAt.
-func NewFatFile(r io.ReaderAt) (*FatFile, error) {
+func NewFatFile(r io.ReaderAt, config ...FatFileConfig) (*FatFile, error) {
 	var ff FatFile
+	var cfg FatFileConfig
+	if config != nil {
+		cfg = config[0]
+	}
+	cfg.FileConfig.Offset = 0
+	cfg.FileConfig.SrcReader = nil
+
 	sr := io.NewSectionReader(r, 0, 1<<63-1)
 
 	// Read the fat_header struct, which is always in big endian.
@@ -96,12 +151,6 @@ func NewFatFile(r io.ReaderAt) (*FatFile, error) {
 		}
 		offset += fatArchHeaderSize
 
-		fr := io.NewSectionReader(r, int64(fa.Offset), int64(fa.Size))
-		fa.File, err = NewFile(fr)
-		if err != nil {
-			return nil, err
-		}
-
 		// Make sure the architecture for this image is not duplicate.
 		seenArch := (uint64(fa.CPU) << 32) | uint64(fa.SubCPU)
 		if o, k := seenArches[seenArch]; o || k {
@@ -109,27 +158,74 @@ func NewFatFile(r io.ReaderAt) (*FatFile, error) {
 		}
 		seenArches[seenArch] = true
 
-		// Make sure the Mach-O type matches that of the first image.
+		fa.lazy = &fatArchLoader{r: r, config: cfg.FileConfig}
+	}
+
+	if !cfg.LazyArches {
+		if err := ff.openArches(cfg.Parallel); err != nil {
+			return nil, err
+		}
+	}
+
+	// Make sure the Mach-O type of every image matches that of the first image.
+	for i := range ff.Arches {
+		fa := &ff.Arches[i]
+		ftype, err := peekFileType(r, int64(fa.Offset))
+		if err != nil {
+			return nil, &FormatError{int64(fa.Offset), fmt.Sprintf("failed to read Mach-O header for architecture #%d: %v", i, err), nil}
+		}
 		if i == 0 {
-			machoType = fa.Type
-		} else {
-			if fa.Type != machoType {
-				return nil, &FormatError{offset, fmt.Sprintf("Mach-O type for architecture #%d (type=%#x) does not match first (type=%#x)", i, fa.Type, machoType), nil}
-			}
+			machoType = ftype
+		} else if ftype != machoType {
+			return nil, &FormatError{int64(8 + fatArchHeaderSize*(i+1)), fmt.Sprintf("Mach-O type for architecture #%d (type=%#x) does not match first (type=%#x)", i, ftype, machoType), nil}
 		}
 	}
 
 	return &ff, nil
 }
 
+// openArches parses every architecture, concurrently if parallel is set, and sets their File
+func (ff *FatFile) openArches(parallel bool) error {
+	if parallel {
+		var wg sync.WaitGroup
+		for i := range ff.Arches {
+			wg.Add(1)
+			go func(fa *FatArch) {
+				defer wg.Done()
+				fa.Open()
+			}(&ff.Arches[i])
+		}
+		wg.Wait()
+	}
+	// errors are reported in architecture order
+	for i := range ff.Arches {
+		f, err := ff.Arches[i].Open()
+		if err != nil {
+			return err
+		}
+		ff.Arches[i].File = f
+	}
+	return nil
+}
+
+// OpenArch returns the Mach-O File of the first architecture for cpu, parsing it if needed
+func (ff *FatFile) OpenArch(cpu types.CPU) (*File, error) {
+	for i := range ff.Arches {
+		if ff.Arches[i].CPU == cpu {
+			return ff.Arches[i].Open()
+		}
+	}
+	return nil, fmt.Errorf("fat file does not contain architecture %s", cpu)
+}
+
 // OpenFat opens the named file using os.Open and prepares it for use as a Mach-O
 // universal binary.
-func OpenFat(name string) (*FatFile, error) {
+func OpenFat(name string, config ...FatFileConfig) (*FatFile, error) {
 	f, err := os.Open(name)
 	if err != nil {
 		return nil, err
 	}
-	ff, err := NewFatFile(f)
+	ff, err := NewFatFile(f, config...)
 	if err != nil {
 		f.Close()
 		return nil, err
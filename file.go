@@ -3,7 +3,6 @@ package macho
 // High level access to low level data structures.
 
 import (
-	"bufio"
 	"bytes"
 	"compress/zlib"
 	"debug/dwarf"
@@ -14,6 +13,7 @@ import (
 	"log"
 	"os"
 	"strings"
+	"sync"
 	"unsafe"
 
 	"github.com/blacktop/go-macho/pkg/codesign"
@@ -29,6 +29,10 @@ const (
 type sections []*Section
 
 // A File represents an open Mach-O file.
+//
+// All of File's read paths use positional reads (ReadAt) and its on-demand caches are
+// guarded by a mutex, so a File is safe for use by multiple concurrent readers as long
+// as none of them modifies it (e.g. through its exported fields or AddLoad).
 type File struct {
 	FileTOC
 
@@ -38,15 +42,35 @@ type File struct {
 	vma    *types.VMAddrConverter
 	dcf    *fixupchains.DyldChainedFixups
 	sr     *io.SectionReader
+	mr     *mmapReader
 	closer io.Closer
+
+	lazy      lazyLoads
+	symidx    *SymbolIndex // guarded by lazy
+	cstrs     cstringCache
+	fsets     fileSetCache
+	objcCache objcCache
+}
+
+// lazyLoads tracks the load command data deferred by FileConfig.LazyLoad;
+// its mutex also guards the File's other on-demand caches
+type lazyLoads struct {
+	sync.Mutex
+	symtab    bool
+	dysymtab  bool
+	relocs    bool
+	codesign  bool
+	symtabOff int64 // LC_SYMTAB load command offset for FormatError
 }
 
 type FileTOC struct {
 	types.FileHeader
-	ByteOrder binary.ByteOrder
-	Loads     []Load
-	Sections  sections
-	functions []types.Function
+	ByteOrder  binary.ByteOrder
+	Loads      []Load
+	Sections   sections
+	functions  []types.Function
+	funcStarts []uint64   // function boundaries decoded from LC_FUNCTION_STARTS (see functions.go)
+	addrs      *addrIndex // cached address lookup tables (see addrindex.go)
 }
 
 func (t *FileTOC) String() string {
@@ -95,6 +119,7 @@ func (t *FileTOC) LoadsString() string {
 }
 
 func (t *FileTOC) AddLoad(l Load) {
+	t.addrs = nil
 	t.Loads = append(t.Loads, l)
 	t.NCommands++
 	t.SizeCommands += l.LoadSize(t)
@@ -116,6 +141,7 @@ func (t *FileTOC) AddSection(s *Section) {
 		g.Firstsect = uint32(len(t.Sections))
 	}
 	g.Nsect++
+	t.addrs = nil
 	t.Sections = append(t.Sections, s)
 	sectionsize := uint32(unsafe.Sizeof(types.Section32{}))
 	if g.Command() == types.LC_SEGMENT_64 {
@@ -267,6 +293,12 @@ type FileConfig struct {
 	Offset          int64
 	LoadFilter      []types.LoadCmd
 	VMAddrConverter types.VMAddrConverter
+	// LazyLoad only decodes the header, load commands and segment/section tables up front.
+	// The File methods that need the symbol table or code signature decode them when first
+	// called, and Section.PutRelocs decodes the relocations, but the Symtab.Syms,
+	// Dysymtab.IndirectSyms and Section.Relocs fields stay empty until ParseSymtab,
+	// ParseDysymtab and ParseRelocs (or Section.ParseRelocs) are called.
+	LazyLoad bool
 
 	SrcReader *io.SectionReader
 }
@@ -286,6 +318,34 @@ func Open(name string) (*File, error) {
 	return ff, nil
 }
 
+// OpenMmap opens the named file and maps it read-only into memory before
+// preparing it for use as a Mach-O binary.
+//
+// Section and Segment data, the symbol table, the exports trie and the chained
+// fixups are returned as views into the mapping instead of being copied, so the
+// returned byte slices MUST NOT be modified and are only valid until Close is called.
+func OpenMmap(name string) (*File, error) {
+	f, err := os.Open(name)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+
+	dat, err := mmap(f)
+	if err != nil {
+		return nil, fmt.Errorf("failed to mmap %s: %v", name, err)
+	}
+	mr := newMmapReader(dat)
+
+	ff, err := NewFile(mr)
+	if err != nil {
+		mr.Close()
+		return nil, err
+	}
+	ff.closer = mr
+	return ff, nil
+}
+
 type segInfo struct {
 	Start uint64
 	End   uint64
@@ -319,6 +379,9 @@ func (f *File) Export(path string, dcf *fixupchains.DyldChainedFixups, baseAddre
 		return fmt.Errorf("failed to write file header to buffer: %v", err)
 	}
 
+	// the segment and section offsets are rewritten below
+	defer f.buildAddrIndex()
+
 	// create segment offset map
 	var newSegOffset uint64
 	for _, seg := range f.Segments() {
@@ -706,6 +769,8 @@ func (f *File) Export(path string, dcf *fixupchains.DyldChainedFixups, baseAddre
 }
 
 // Close closes the File.
+// If the File was created using OpenMmap, Close also unmaps the file and
+// any data slices previously returned from it become invalid.
 // If the File was created using NewFile directly instead of Open,
 // Close has no effect.
 func (f *File) Close() error {
@@ -724,15 +789,20 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 
 	f := new(File)
 
-	if config != nil {
-		if config[0].SrcReader != nil {
-			f.sr = config[0].SrcReader
-			f.sr.Seek(config[0].Offset, io.SeekStart)
+	hdr := io.NewSectionReader(r, 0, 1<<63-1)
+	if config != nil && config[0].SrcReader != nil {
+		f.sr = config[0].SrcReader
+		hdr = io.NewSectionReader(f.sr, config[0].Offset, 1<<63-1-config[0].Offset)
+	} else {
+		f.sr = io.NewSectionReader(r, 0, 1<<63-1)
+		if mr, ok := r.(*mmapReader); ok {
+			f.mr = mr
 		}
+	}
+
+	if config != nil && config[0].VMAddrConverter.Converter != nil {
 		f.vma = &config[0].VMAddrConverter
-		loadsFilter = config[0].LoadFilter
 	} else {
-		f.sr = io.NewSectionReader(r, 0, 1<<63-1)
 		f.vma = &types.VMAddrConverter{
 			Converter:    f.convertToVMAddr,
 			VMAddr2Offet: f.GetOffset,
@@ -740,6 +810,12 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 		}
 	}
 
+	var lazy bool
+	if config != nil {
+		loadsFilter = config[0].LoadFilter
+		lazy = config[0].LazyLoad
+	}
+
 	// Read and decode Mach magic to determine byte order, size.
 	// Magic32 and Magic64 differ only in the bottom bit.
 	var ident [4]byte
@@ -760,7 +836,7 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 	}
 
 	// Read entire file header.
-	if err := binary.Read(f.sr, f.ByteOrder, &f.FileHeader); err != nil {
+	if err := binary.Read(hdr, f.ByteOrder, &f.FileHeader); err != nil {
 		return nil, fmt.Errorf("failed to parse header: %v", err)
 	}
 
@@ -801,9 +877,12 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 			f.Loads[i] = LoadCmdBytes{types.LoadCmd(cmd), LoadBytes(cmddat)}
 		case types.LC_SEGMENT:
 			var seg32 types.Segment32
-			b := bytes.NewReader(cmddat)
-			if err := binary.Read(b, bo, &seg32); err != nil {
-				return nil, fmt.Errorf("failed to read LC_SEGMENT: %v", err)
+			if len(cmddat) < types.Segment32Size {
+				return nil, fmt.Errorf("failed to read LC_SEGMENT: %v", io.ErrUnexpectedEOF)
+			}
+			b := cmddat[seg32.Get(cmddat, bo):]
+			if len(b) < int(seg32.Nsect)*types.Section32Size {
+				return nil, fmt.Errorf("failed to read Section32: %v", io.ErrUnexpectedEOF)
 			}
 			s = new(Segment)
 			s.LoadBytes = cmddat
@@ -822,9 +901,7 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 			f.Loads[i] = s
 			for i := 0; i < int(s.Nsect); i++ {
 				var sh32 types.Section32
-				if err := binary.Read(b, bo, &sh32); err != nil {
-					return nil, fmt.Errorf("failed to read Section32: %v", err)
-				}
+				b = b[sh32.Get(b, bo):]
 				sh := new(Section)
 				sh.Type = 32
 				sh.Name = cstring(sh32.Name[0:])
@@ -838,15 +915,18 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 				sh.Flags = sh32.Flags
 				sh.Reserved1 = sh32.Reserve1
 				sh.Reserved2 = sh32.Reserve2
-				if err := f.pushSection(sh, r); err != nil {
+				if err := f.pushSection(sh, lazy); err != nil {
 					return nil, fmt.Errorf("failed to pushSection32: %v", err)
 				}
 			}
 		case types.LC_SEGMENT_64:
 			var seg64 types.Segment64
-			b := bytes.NewReader(cmddat)
-			if err := binary.Read(b, bo, &seg64); err != nil {
-				return nil, fmt.Errorf("failed to read LC_SEGMENT_64: %v", err)
+			if len(cmddat) < types.Segment64Size {
+				return nil, fmt.Errorf("failed to read LC_SEGMENT_64: %v", io.ErrUnexpectedEOF)
+			}
+			b := cmddat[seg64.Get(cmddat, bo):]
+			if len(b) < int(seg64.Nsect)*types.Section64Size {
+				return nil, fmt.Errorf("failed to read Section64: %v", io.ErrUnexpectedEOF)
 			}
 			s = new(Segment)
 			s.LoadBytes = cmddat
@@ -865,9 +945,7 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 			f.Loads[i] = s
 			for i := 0; i < int(s.Nsect); i++ {
 				var sh64 types.Section64
-				if err := binary.Read(b, bo, &sh64); err != nil {
-					return nil, fmt.Errorf("failed to read Section64: %v", err)
-				}
+				b = b[sh64.Get(b, bo):]
 				sh := new(Section)
 				sh.Type = 64
 				sh.Name = cstring(sh64.Name[0:])
@@ -882,7 +960,7 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 				sh.Reserved1 = sh64.Reserve1
 				sh.Reserved2 = sh64.Reserve2
 				sh.Reserved3 = sh64.Reserve3
-				if err := f.pushSection(sh, r); err != nil {
+				if err := f.pushSection(sh, lazy); err != nil {
 					return nil, fmt.Errorf("failed to pushSection64: %v", err)
 				}
 			}
@@ -905,25 +983,16 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 			}
 			hdr.Stroff = uint32(off)
 
-			strtab := make([]byte, hdr.Strsize)
-			if _, err := f.sr.ReadAt(strtab, int64(hdr.Stroff)); err != nil {
-				return nil, fmt.Errorf("failed to read data at Stroff=%#x; %v", int64(hdr.Stroff), err)
-			}
-
-			var symsz int
-			if f.Magic == types.Magic64 {
-				symsz = 16
+			var st *Symtab
+			if lazy {
+				st = &Symtab{LoadBytes: cmddat, SymtabCmd: hdr}
+				f.lazy.symtab = true
+				f.lazy.symtabOff = offset
 			} else {
-				symsz = 12
-			}
-			symdat := make([]byte, int(hdr.Nsyms)*symsz)
-			if _, err := f.sr.ReadAt(symdat, int64(hdr.Symoff)); err != nil {
-				return nil, fmt.Errorf("failed to read data at Symoff=%#x; %v", int64(hdr.Symoff), err)
-			}
-
-			st, err := f.parseSymtab(symdat, strtab, cmddat, &hdr, offset)
-			if err != nil {
-				return nil, fmt.Errorf("failed to read parseSymtab: %v", err)
+				st, err = f.readSymtab(cmddat, &hdr, offset)
+				if err != nil {
+					return nil, err
+				}
 			}
 			st.LoadBytes = cmddat
 			st.LoadCmd = cmd
@@ -963,20 +1032,16 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 			if err := binary.Read(b, bo, &hdr); err != nil {
 				return nil, fmt.Errorf("failed to read LC_DYSYMTAB: %v", err)
 			}
-			dat := make([]byte, hdr.Nindirectsyms*4)
-			if _, err := f.sr.ReadAt(dat, int64(hdr.Indirectsymoff)); err != nil {
-				return nil, fmt.Errorf("failed to read data at Indirectsymoff=%#x; %v", int64(hdr.Indirectsymoff), err)
-			}
-			x := make([]uint32, hdr.Nindirectsyms)
-			if err := binary.Read(bytes.NewReader(dat), bo, x); err != nil {
-				return nil, fmt.Errorf("failed to read Nindirectsyms: %v", err)
-			}
 			st := new(Dysymtab)
 			st.LoadBytes = cmddat
 			st.LoadCmd = cmd
 			st.Len = siz
 			st.DysymtabCmd = hdr
-			st.IndirectSyms = x
+			if lazy {
+				f.lazy.dysymtab = true
+			} else if err := f.readIndirectSymbols(st); err != nil {
+				return nil, err
+			}
 			f.Loads[i] = st
 			f.Dysymtab = st
 		case types.LC_LOAD_DYLIB:
@@ -1171,15 +1236,11 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 			l.Len = siz
 			l.Offset = hdr.Offset
 			l.Size = hdr.Size
-			csdat := make([]byte, hdr.Size)
-			if _, err := r.ReadAt(csdat, int64(hdr.Offset)); err != nil {
-				return nil, fmt.Errorf("failed to read CS data at offset=%#x; %v", int64(hdr.Offset), err)
-			}
-			cs, err := codesign.ParseCodeSignature(csdat)
-			if err != nil {
-				return nil, fmt.Errorf("failed to ParseCodeSignature: %v", err)
+			if lazy {
+				f.lazy.codesign = true
+			} else if err := f.readCodeSignature(l); err != nil {
+				return nil, err
 			}
-			l.CodeSignature = *cs
 			f.Loads[i] = l
 		case types.LC_SEGMENT_SPLIT_INFO:
 			var hdr types.SegmentSplitInfoCmd
@@ -1201,8 +1262,9 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 			l.Len = siz
 			l.Offset = hdr.Offset
 			l.Size = hdr.Size
-			ldat := make([]byte, l.Size)
-			if _, err := r.ReadAt(ldat, int64(l.Offset)); err != nil {
+			// only the version is decoded (see below), so don't read the whole blob
+			ldat, err := f.readData(int64(l.Offset), uint64(binary.Size(l.Version)))
+			if err != nil {
 				return nil, fmt.Errorf("failed to read SplitInfo data at offset=%#x; %v", int64(hdr.Offset), err)
 			}
 			fsr := bytes.NewReader(ldat)
@@ -1604,27 +1666,138 @@ func NewFile(r io.ReaderAt, config ...FileConfig) (*File, error) {
 		}
 		if s != nil {
 			// s.sr = io.NewSectionReader(r, int64(s.Offset), int64(s.Filesz))
-			s.ReaderAt = f.sr
+			s.ReaderAt = f.dataReader()
+		}
+	}
+	if lazy {
+		f.lazy.relocs = true
+		for _, sh := range f.Sections {
+			sh.parseRelocs = f.ParseRelocs
 		}
 	}
+
+	f.buildAddrIndex()
+
 	return f, nil
 }
 
+// ParseSymtab decodes the LC_SYMTAB symbols into f.Symtab.Syms if they were deferred by FileConfig.LazyLoad.
+func (f *File) ParseSymtab() error {
+	f.lazy.Lock()
+	defer f.lazy.Unlock()
+	if !f.lazy.symtab {
+		return nil
+	}
+	st, err := f.readSymtab(f.Symtab.LoadBytes, &f.Symtab.SymtabCmd, f.lazy.symtabOff)
+	if err != nil {
+		return err
+	}
+	f.Symtab.Syms = st.Syms
+	f.Symtab.strtab = st.strtab
+	f.lazy.symtab = false
+	return nil
+}
+
+// ParseDysymtab decodes the LC_DYSYMTAB indirect symbols into f.Dysymtab.IndirectSyms if they were deferred by FileConfig.LazyLoad.
+func (f *File) ParseDysymtab() error {
+	f.lazy.Lock()
+	defer f.lazy.Unlock()
+	if !f.lazy.dysymtab {
+		return nil
+	}
+	if err := f.readIndirectSymbols(f.Dysymtab); err != nil {
+		return err
+	}
+	f.lazy.dysymtab = false
+	return nil
+}
+
+// ParseRelocs decodes the relocations of all sections if they were deferred by FileConfig.LazyLoad.
+func (f *File) ParseRelocs() error {
+	f.lazy.Lock()
+	defer f.lazy.Unlock()
+	if !f.lazy.relocs {
+		return nil
+	}
+	for _, sh := range f.Sections {
+		if err := f.readRelocs(sh); err != nil {
+			return err
+		}
+	}
+	f.lazy.relocs = false
+	return nil
+}
+
+func (f *File) readSymtab(cmddat []byte, hdr *types.SymtabCmd, offset int64) (*Symtab, error) {
+	strtab, err := f.readData(int64(hdr.Stroff), uint64(hdr.Strsize))
+	if err != nil {
+		return nil, fmt.Errorf("failed to read data at Stroff=%#x; %v", int64(hdr.Stroff), err)
+	}
+
+	var symsz int
+	if f.Magic == types.Magic64 {
+		symsz = 16
+	} else {
+		symsz = 12
+	}
+	symdat, err := f.readData(int64(hdr.Symoff), uint64(hdr.Nsyms)*uint64(symsz))
+	if err != nil {
+		return nil, fmt.Errorf("failed to read data at Symoff=%#x; %v", int64(hdr.Symoff), err)
+	}
+
+	st, err := f.parseSymtab(symdat, strtab, cmddat, hdr, offset)
+	if err != nil {
+		return nil, fmt.Errorf("failed to read parseSymtab: %v", err)
+	}
+	return st, nil
+}
+
+func (f *File) readIndirectSymbols(st *Dysymtab) error {
+	dat, err := f.readData(int64(st.Indirectsymoff), uint64(st.Nindirectsyms)*4)
+	if err != nil {
+		return fmt.Errorf("failed to read data at Indirectsymoff=%#x; %v", int64(st.Indirectsymoff), err)
+	}
+	x := make([]uint32, st.Nindirectsyms)
+	if err := binary.Read(bytes.NewReader(dat), f.ByteOrder, x); err != nil {
+		return fmt.Errorf("failed to read Nindirectsyms: %v", err)
+	}
+	st.IndirectSyms = x
+	return nil
+}
+
+func (f *File) readCodeSignature(cs *CodeSignature) error {
+	csdat, err := f.readData(int64(cs.Offset), uint64(cs.Size))
+	if err != nil {
+		return fmt.Errorf("failed to read CS data at offset=%#x; %v", int64(cs.Offset), err)
+	}
+	c, err := codesign.ParseCodeSignature(csdat)
+	if err != nil {
+		return fmt.Errorf("failed to ParseCodeSignature: %v", err)
+	}
+	cs.CodeSignature = *c
+	return nil
+}
+
 func (f *File) parseSymtab(symdat, strtab, cmddat []byte, hdr *types.SymtabCmd, offset int64) (*Symtab, error) {
 	bo := f.ByteOrder
 	symtab := make([]Symbol, hdr.Nsyms)
-	b := bytes.NewReader(symdat)
+	// copy the string table once; every symbol name is a view into it so
+	// names sharing a strtab offset share storage
+	arena := string(strtab)
+	nlistSize := 12
+	if f.Magic == types.Magic64 {
+		nlistSize = 16
+	}
+	if len(symdat) < len(symtab)*nlistSize {
+		return nil, fmt.Errorf("failed to read Symtab nlists: %v", io.ErrUnexpectedEOF)
+	}
 	for i := range symtab {
 		var n types.Nlist64
 		if f.Magic == types.Magic64 {
-			if err := binary.Read(b, bo, &n); err != nil {
-				return nil, fmt.Errorf("failed to read Symtab magic: %v", err)
-			}
+			n.Get64(symdat[i*nlistSize:], bo)
 		} else {
 			var n32 types.Nlist32
-			if err := binary.Read(b, bo, &n32); err != nil {
-				return nil, fmt.Errorf("failed to read Symtab nlist32: %v", err)
-			}
+			n32.Get32(symdat[i*nlistSize:], bo)
 			n.Name = n32.Name
 			n.Type = n32.Type
 			n.Sect = n32.Sect
@@ -1636,7 +1809,7 @@ func (f *File) parseSymtab(symdat, strtab, cmddat []byte, hdr *types.SymtabCmd,
 			return nil, &FormatError{offset, "invalid name in symbol table", n.Name}
 		}
 		// We add "_" to Go symbols. Strip it here. See issue 33808.
-		name := cstring(strtab[n.Name:])
+		name := cstringAt(arena, n.Name)
 		if strings.Contains(name, ".") && name[0] == '_' {
 			name = name[1:]
 		}
@@ -1654,20 +1827,31 @@ func (f *File) parseSymtab(symdat, strtab, cmddat []byte, hdr *types.SymtabCmd,
 	st.Strsize = hdr.Strsize
 	st.Len = hdr.Len
 	st.Syms = symtab
+	st.strtab = arena
 	return st, nil
 }
 
-func (f *File) pushSection(sh *Section, r io.ReaderAt) error {
+func (f *File) pushSection(sh *Section, lazy bool) error {
 	f.Sections = append(f.Sections, sh)
 	// sh.sr = io.NewSectionReader(r, int64(sh.Offset), int64(sh.Size))
-	sh.ReaderAt = f.sr
+	sh.ReaderAt = f.dataReader()
+
+	if lazy {
+		return nil
+	}
+
+	return f.readRelocs(sh)
+}
 
+func (f *File) readRelocs(sh *Section) error {
 	if sh.Nreloc > 0 {
-		reldat := make([]byte, int(sh.Nreloc)*8)
-		if _, err := r.ReadAt(reldat, int64(sh.Reloff)); err != nil {
+		reldat, err := f.readData(int64(sh.Reloff), uint64(sh.Nreloc)*8)
+		if err != nil {
 			return fmt.Errorf("failed to read data at Reloff=%#x; %v", int64(sh.Reloff), err)
 		}
-		b := bytes.NewReader(reldat)
+		if len(reldat) < int(sh.Nreloc)*8 {
+			return fmt.Errorf("failed to read relocInfo; %v", io.ErrUnexpectedEOF)
+		}
 
 		bo := f.ByteOrder
 
@@ -1675,9 +1859,9 @@ func (f *File) pushSection(sh *Section, r io.ReaderAt) error {
 		for i := range sh.Relocs {
 			rel := &sh.Relocs[i]
 
-			var ri relocInfo
-			if err := binary.Read(b, bo, &ri); err != nil {
-				return fmt.Errorf("failed to read relocInfo; %v", err)
+			ri := relocInfo{
+				Addr:   bo.Uint32(reldat[i*8:]),
+				Symnum: bo.Uint32(reldat[i*8+4:]),
 			}
 
 			if ri.Addr&(1<<31) != 0 { // scattered
@@ -1721,6 +1905,15 @@ func cstring(b []byte) string {
 	return string(b[0:i])
 }
 
+// cstringAt returns the NUL terminated string at off as a view into arena
+func cstringAt(arena string, off uint32) string {
+	s := arena[off:]
+	if i := strings.IndexByte(s, 0); i != -1 {
+		return s[:i]
+	}
+	return s
+}
+
 func (f *File) is64bit() bool { return f.FileHeader.Magic == types.Magic64 }
 
 func (f *File) pointerSize() uint64 {
@@ -1769,20 +1962,53 @@ func (f *File) ReadAt(p []byte, off int64) (n int, err error) {
 	return f.sr.ReadAt(p, off)
 }
 
+// newReader returns a reader positioned at offset off within MachO with its own
+// cursor so that concurrent readers never share (or race on) f.sr's Seek state
+func (f *File) newReader(off int64) *io.SectionReader {
+	return io.NewSectionReader(f.sr, off, 1<<63-1-off)
+}
+
+// dataReader returns the ReaderAt that Sections and Segments read their data from
+func (f *File) dataReader() io.ReaderAt {
+	if f.mr != nil {
+		return f.mr
+	}
+	return f.sr
+}
+
+// readData returns size bytes at offset off within MachO; if the File was opened
+// with OpenMmap this is a view into the mapping, otherwise it is a fresh copy.
+func (f *File) readData(off int64, size uint64) ([]byte, error) {
+	if f.mr != nil {
+		return f.mr.Slice(off, size)
+	}
+	dat := make([]byte, size)
+	if _, err := f.sr.ReadAt(dat, off); err != nil {
+		return nil, err
+	}
+	return dat, nil
+}
+
 // GetOffset returns the file offset for a given virtual address
 func (f *File) GetOffset(address uint64) (uint64, error) {
-	for _, seg := range f.Segments() {
-		if seg.Addr <= address && address < seg.Addr+seg.Memsz {
-			return (address - seg.Addr) + seg.Offset, nil
-		}
+	if seg := f.FindSegmentForVMAddr(address); seg != nil {
+		return (address - seg.Addr) + seg.Offset, nil
 	}
 	return 0, fmt.Errorf("address 0x%x not within any segments adress range", address)
 }
 
 // GetVMAddress returns the virtal address for a given file offset
 func (f *File) GetVMAddress(offset uint64) (uint64, error) {
-	for _, seg := range f.Segments() {
-		if seg.Offset <= offset && offset < seg.Offset+seg.Filesz {
+	if idx := f.addrs; idx != nil && idx.segOffs != nil {
+		// a hit is only trusted if the segment still covers offset (see addrIndex)
+		if i := idx.segOffs.find(offset); i >= 0 {
+			if seg := idx.segs[i]; seg.Offset <= offset && offset < seg.Offset+seg.Filesz {
+				return (offset - seg.Offset) + seg.Addr, nil
+			}
+		}
+	}
+	for _, l := range f.Loads {
+		if seg, ok := l.(*Segment); ok && seg.Offset <= offset && offset < seg.Offset+seg.Filesz {
 			return (offset - seg.Offset) + seg.Addr, nil
 		}
 	}
@@ -1813,20 +2039,27 @@ func (f *File) GetBindName(pointer uint64) (string, error) {
 	var err error
 
 	if f.HasFixups() {
+		f.lazy.Lock()
 		if f.dcf == nil {
 			f.dcf, err = f.DyldChainedFixups()
 			if err != nil {
+				f.lazy.Unlock()
 				return "", fmt.Errorf("failed to parse dyld chained fixups: %v", err)
 			}
 		}
+		f.lazy.Unlock()
 		if len(f.dcf.Imports) > 0 {
 			if !fixupchains.DcpArm64eIsRebase(pointer) {
+				var ordinal uint64
 				if fixupchains.DcpArm64eIsAuth(pointer) {
-					authBind := fixupchains.DyldChainedPtrArm64eAuthBind{Pointer: pointer}
-					return f.dcf.Imports[authBind.Ordinal()].Name, nil
+					ordinal = fixupchains.DyldChainedPtrArm64eAuthBind{Pointer: pointer}.Ordinal()
+				} else {
+					ordinal = fixupchains.DyldChainedPtrArm64eBind{Pointer: pointer}.Ordinal()
+				}
+				if ordinal >= uint64(len(f.dcf.Imports)) {
+					return "", fmt.Errorf("bind ordinal %d of pointer %#x is out of range (%d imports)", ordinal, pointer, len(f.dcf.Imports))
 				}
-				bind := fixupchains.DyldChainedPtrArm64eBind{Pointer: pointer}
-				return f.dcf.Imports[bind.Ordinal()].Name, nil
+				return f.dcf.Imports[ordinal].Name, nil
 			}
 		}
 	}
@@ -1851,23 +2084,25 @@ func (f *File) GetCString(strVMAdr uint64) (string, error) {
 	return f.GetCStringAtOffset(int64(strOffset))
 }
 
-// GetCStringAtOffset returns a c-string at a given offset into the MachO
+// GetCStringAtOffset returns a c-string at a given offset into the MachO.
+// Strings are cached per File by offset (see also IndexCStrings).
 func (f *File) GetCStringAtOffset(strOffset int64) (string, error) {
 
-	if _, err := f.sr.Seek(strOffset, io.SeekStart); err != nil {
-		return "", fmt.Errorf("failed to Seek to offset 0x%x: %v", strOffset, err)
+	if strOffset < 0 {
+		return "", fmt.Errorf("invalid cstring offset 0x%x", strOffset)
 	}
 
-	s, err := bufio.NewReader(f.sr).ReadString('\x00')
-	if err != nil {
-		return "", fmt.Errorf("failed to ReadString as offset 0x%x, %v", strOffset, err)
+	if s, ok := f.cachedCString(strOffset); ok {
+		return s, nil
 	}
 
-	if len(s) > 0 {
-		return strings.Trim(s, "\x00"), nil
+	s, err := f.readCString(strOffset)
+	if err != nil {
+		return "", err
 	}
+	f.cacheCString(strOffset, s)
 
-	return "", fmt.Errorf("string not found at offset 0x%x", strOffset)
+	return s, nil
 }
 
 // Segment returns the first Segment with the given name, or nil if no such segment exists.
@@ -1920,8 +2155,15 @@ func (f *File) Section(segment, section string) *Section {
 
 // FindSegmentForVMAddr returns the segment containing a given virtual memory ddress.
 func (f *File) FindSegmentForVMAddr(vmAddr uint64) *Segment {
-	for _, seg := range f.Segments() {
-		if seg.Addr <= vmAddr && vmAddr < seg.Addr+seg.Memsz {
+	if idx := f.addrs; idx != nil && idx.segAddrs != nil {
+		if i := idx.segAddrs.find(vmAddr); i >= 0 {
+			if seg := idx.segs[i]; seg.Addr <= vmAddr && vmAddr < seg.Addr+seg.Memsz {
+				return seg
+			}
+		}
+	}
+	for _, l := range f.Loads {
+		if seg, ok := l.(*Segment); ok && seg.Addr <= vmAddr && vmAddr < seg.Addr+seg.Memsz {
 			return seg
 		}
 	}
@@ -1930,6 +2172,13 @@ func (f *File) FindSegmentForVMAddr(vmAddr uint64) *Segment {
 
 // FindSectionForVMAddr returns the section containing a given virtual memory ddress.
 func (f *File) FindSectionForVMAddr(vmAddr uint64) *Section {
+	if idx := f.addrs; idx != nil && idx.secAddrs != nil {
+		if i := idx.secAddrs.find(vmAddr); i >= 0 && i < len(f.Sections) {
+			if sec := f.Sections[i]; sec.Addr <= vmAddr && vmAddr < sec.Addr+sec.Size {
+				return sec
+			}
+		}
+	}
 	for _, sec := range f.Sections {
 		if sec.Addr <= vmAddr && vmAddr < sec.Addr+sec.Size {
 			return sec
@@ -1999,21 +2248,6 @@ func (f *File) FileSets() []*FilesetEntry {
 	return fsets
 }
 
-// GetFileSetFileByName returns the Fileset MachO for a given name.
-func (f *File) GetFileSetFileByName(name string) (*File, error) {
-	for _, l := range f.Loads {
-		if fs, ok := l.(*FilesetEntry); ok {
-			if strings.Contains(strings.ToLower(fs.EntryID), strings.ToLower(name)) {
-				return NewFile(io.NewSectionReader(f.sr, int64(fs.Offset), 1<<63-1), FileConfig{
-					Offset:    int64(fs.Offset),
-					SrcReader: f.sr,
-				})
-			}
-		}
-	}
-	return nil, fmt.Errorf("fileset does NOT contain %s", name)
-}
-
 // FunctionStarts returns the function starts array, or nil if none exists.
 func (f *File) FunctionStarts() *FunctionStarts {
 	for _, l := range f.Loads {
@@ -2026,62 +2260,24 @@ func (f *File) FunctionStarts() *FunctionStarts {
 
 // GetFunctions returns the function array, or nil if none exists.
 func (f *File) GetFunctions(data ...byte) []types.Function {
+	f.lazy.Lock()
+	defer f.lazy.Unlock()
 
 	if len(f.functions) > 0 {
 		return f.functions
 	}
 
-	var funcs []types.Function
-
-	fs := f.FunctionStarts()
-	if fs == nil {
-		return nil
-	}
-
-	var fsr *bytes.Reader
-	if len(data) > 0 {
-		fsr = bytes.NewReader(data)
-	} else {
-		ldat := make([]byte, fs.Size)
-		if _, err := f.sr.ReadAt(ldat, int64(fs.Offset)); err != nil {
-			return nil
-		}
-		fsr = bytes.NewReader(ldat)
-	}
-
-	offset, err := trie.ReadUleb128(fsr)
-	if err != nil {
+	starts := f.functionStartsLocked(data)
+	if len(starts) < 2 {
 		return nil
 	}
 
-	startVMA := offset + f.GetBaseAddress()
-
-	for {
-		offset, err = trie.ReadUleb128(fsr)
-		if err == io.EOF {
-			break
-		}
-		if offset == 0 {
-			break
+	funcs := make([]types.Function, len(starts)-1)
+	for i := range funcs {
+		funcs[i] = types.Function{
+			StartAddr: starts[i],
+			EndAddr:   starts[i+1],
 		}
-		if err != nil {
-			return nil
-		}
-
-		funcs = append(funcs, types.Function{
-			StartAddr: startVMA,
-			EndAddr:   startVMA + offset,
-		})
-
-		startVMA += offset
-	}
-
-	// get last function
-	if s := f.FindSectionForVMAddr(startVMA); s != nil {
-		funcs = append(funcs, types.Function{
-			StartAddr: startVMA,
-			EndAddr:   s.Addr + s.Size,
-		})
 	}
 
 	// cache parsed functions
@@ -2092,10 +2288,9 @@ func (f *File) GetFunctions(data ...byte) []types.Function {
 
 // GetFunctionForVMAddr returns the function containing a given virual address
 func (f *File) GetFunctionForVMAddr(addr uint64) (types.Function, error) {
-	for _, f := range f.GetFunctions() {
-		if addr >= f.StartAddr && addr < f.EndAddr {
-			return f, nil
-		}
+	starts := f.functionStarts()
+	if i := searchFunctionStarts(starts, addr); i >= 0 {
+		return types.Function{StartAddr: starts[i], EndAddr: starts[i+1]}, nil
 	}
 	return types.Function{}, fmt.Errorf("address %#016x not in any function", addr)
 }
@@ -2114,9 +2309,19 @@ func (f *File) GetFunctionData(fn types.Function) ([]byte, error) {
 }
 
 // CodeSignature returns the code signature, or nil if none exists.
+// If the code signature was deferred by FileConfig.LazyLoad it is parsed first,
+// and nil is returned if that fails.
 func (f *File) CodeSignature() *CodeSignature {
 	for _, l := range f.Loads {
 		if s, ok := l.(*CodeSignature); ok {
+			f.lazy.Lock()
+			defer f.lazy.Unlock()
+			if f.lazy.codesign {
+				if err := f.readCodeSignature(s); err != nil {
+					return nil
+				}
+				f.lazy.codesign = false
+			}
 			return s
 		}
 	}
@@ -2133,25 +2338,78 @@ func (f *File) DyldExportsTrie() *DyldExportsTrie {
 	return nil
 }
 
+// dyldExportsData returns the LC_DYLD_EXPORTS_TRIE data
+func (f *File) dyldExportsData() ([]byte, error) {
+	dxt := f.DyldExportsTrie()
+	if dxt == nil {
+		return nil, fmt.Errorf("macho does not contain LC_DYLD_EXPORTS_TRIE")
+	}
+	if dxt.Size == 0 {
+		return nil, nil
+	}
+	data, err := f.readData(int64(dxt.Offset), uint64(dxt.Size))
+	if err != nil {
+		return nil, fmt.Errorf("failed to read %s data at offset=%#x; %v", types.LC_DYLD_EXPORTS_TRIE, int64(dxt.Offset), err)
+	}
+	return data, nil
+}
+
 // DyldExports returns the dyld export trie symbols
 func (f *File) DyldExports() ([]trie.TrieEntry, error) {
+	data, err := f.dyldExportsData()
+	if err != nil {
+		return nil, err
+	}
+	if len(data) == 0 {
+		return []trie.TrieEntry{}, nil
+	}
+	exports, err := trie.ParseTrie(data, f.GetBaseAddress())
+	if err != nil {
+		return nil, fmt.Errorf("failed to parse %s: %v", types.LC_DYLD_EXPORTS_TRIE, err)
+	}
+	return exports, nil
+}
 
-	if dxt := f.DyldExportsTrie(); dxt != nil {
-		if dxt.Size == 0 {
-			return []trie.TrieEntry{}, nil
-		}
-		data := make([]byte, dxt.Size)
-		if _, err := f.sr.ReadAt(data, int64(dxt.Offset)); err != nil {
-			return nil, fmt.Errorf("failed to read %s data at offset=%#x; %v", types.LC_DYLD_EXPORTS_TRIE, int64(dxt.Offset), err)
-		}
-		exports, err := trie.ParseTrie(data, f.GetBaseAddress())
-		if err != nil {
-			return nil, fmt.Errorf("failed to parse %s: %v", types.LC_DYLD_EXPORTS_TRIE, err)
+// ForEachExport calls fn for each dyld export trie symbol as it is decoded, without collecting them.
+// If fn returns trie.ErrStopWalk the walk stops early; any other error from fn is returned as is.
+func (f *File) ForEachExport(fn func(trie.TrieEntry) error) error {
+	return f.ForEachExportWithPrefix("", fn)
+}
+
+// ForEachExportWithPrefix is like ForEachExport but only visits the symbols starting with prefix
+func (f *File) ForEachExportWithPrefix(prefix string, fn func(trie.TrieEntry) error) error {
+	data, err := f.dyldExportsData()
+	if err != nil {
+		return err
+	}
+	if len(data) == 0 {
+		return nil
+	}
+	var fnErr error
+	if err := trie.WalkPrefix(data, f.GetBaseAddress(), prefix, func(e trie.TrieEntry) error {
+		fnErr = fn(e)
+		return fnErr
+	}); err != nil {
+		if err == fnErr {
+			return err
 		}
-		return exports, nil
+		return fmt.Errorf("failed to parse %s: %v", types.LC_DYLD_EXPORTS_TRIE, err)
 	}
+	return nil
+}
 
-	return nil, fmt.Errorf("macho does not contain LC_DYLD_EXPORTS_TRIE")
+// LookupExports resolves the sorted symbol names against the dyld export trie in one traversal.
+// The i-th entry is the export of symbols[i], with an empty Name if it is not exported.
+func (f *File) LookupExports(symbols []string) ([]trie.TrieEntry, error) {
+	data, err := f.dyldExportsData()
+	if err != nil {
+		return nil, err
+	}
+	exports, err := trie.LookupSymbols(data, f.GetBaseAddress(), symbols)
+	if err != nil {
+		return nil, fmt.Errorf("failed to lookup symbols in %s: %v", types.LC_DYLD_EXPORTS_TRIE, err)
+	}
+	return exports, nil
 }
 
 // HasFixups does macho contain a LC_DYLD_CHAINED_FIXUPS load command
@@ -2166,10 +2424,35 @@ func (f *File) HasFixups() bool {
 
 // DyldChainedFixups returns the dyld chained fixups.
 func (f *File) DyldChainedFixups() (*fixupchains.DyldChainedFixups, error) {
+	return f.DyldChainedFixupsParallel(1)
+}
+
+// DyldChainedFixupsParallel is DyldChainedFixups walking the fixup chains of different pages
+// on up to workers goroutines (runtime.NumCPU() if workers <= 0). The result is identical.
+func (f *File) DyldChainedFixupsParallel(workers int) (*fixupchains.DyldChainedFixups, error) {
+	dcf, err := f.dyldChainedFixupStarts()
+	if err != nil {
+		return nil, err
+	}
+	return dcf.ParseParallel(workers)
+}
+
+// ForEachFixup decodes the dyld chained fixups on the fly calling fn for each one until fn
+// returns false, without materializing them all (see DyldChainedFixups.ForEachFixup)
+func (f *File) ForEachFixup(fn func(fixupchains.Fixup) bool) error {
+	dcf, err := f.dyldChainedFixupStarts()
+	if err != nil {
+		return err
+	}
+	return dcf.ForEachFixup(fn)
+}
+
+// dyldChainedFixupStarts returns the LC_DYLD_CHAINED_FIXUPS with only its chain starts parsed
+func (f *File) dyldChainedFixupStarts() (*fixupchains.DyldChainedFixups, error) {
 	for _, l := range f.Loads {
 		if dcfLC, ok := l.(*DyldChainedFixups); ok {
-			data := make([]byte, dcfLC.Size)
-			if _, err := f.sr.ReadAt(data, int64(dcfLC.Offset)); err != nil {
+			data, err := f.readData(int64(dcfLC.Offset), uint64(dcfLC.Size))
+			if err != nil {
 				return nil, fmt.Errorf("failed to read DyldChainedFixups data at offset=%#x; %v", int64(dcfLC.Offset), err)
 			}
 			dcf := fixupchains.NewChainedFixups(bytes.NewReader(data), f.sr, f.ByteOrder)
@@ -2187,7 +2470,7 @@ func (f *File) DyldChainedFixups() (*fixupchains.DyldChainedFixups, error) {
 					dcf.Starts[idx].SegmentOffset = segs[idx].Offset
 				}
 			}
-			return dcf.Parse()
+			return dcf, nil
 		}
 	}
 	return nil, fmt.Errorf("macho does not contain LC_DYLD_CHAINED_FIXUPS")
@@ -2284,6 +2567,9 @@ func (f *File) ImportedSymbols() ([]Symbol, error) {
 	if f.Dysymtab == nil || f.Symtab == nil {
 		return nil, &FormatError{0, "missing symbol table", nil}
 	}
+	if err := f.ParseSymtab(); err != nil {
+		return nil, err
+	}
 
 	st := f.Symtab
 	dt := f.Dysymtab
@@ -2360,6 +2646,18 @@ func (f *File) LibraryOrdinalName(libraryOrdinal int) string {
 }
 
 func (f *File) FindSymbolAddress(symbol string) (uint64, error) {
+	if f.Symtab == nil {
+		return 0, fmt.Errorf("macho does not contain a symtab")
+	}
+	if err := f.ParseSymtab(); err != nil {
+		return 0, err
+	}
+	if idx := f.symbolIndex(); idx != nil {
+		if sym, ok := idx.LookupFold(symbol); ok {
+			return sym.Value, nil
+		}
+		return 0, fmt.Errorf("symbol not found in macho symtab")
+	}
 	for _, sym := range f.Symtab.Syms {
 		if strings.EqualFold(sym.Name, symbol) {
 			return sym.Value, nil
@@ -2370,9 +2668,19 @@ func (f *File) FindSymbolAddress(symbol string) (uint64, error) {
 
 func (f *File) FindAddressSymbols(addr uint64) ([]Symbol, error) {
 	var syms []Symbol
-	for _, sym := range f.Symtab.Syms {
-		if sym.Value == addr {
-			syms = append(syms, sym)
+	if f.Symtab == nil {
+		return nil, fmt.Errorf("macho does not contain a symtab")
+	}
+	if err := f.ParseSymtab(); err != nil {
+		return nil, err
+	}
+	if idx := f.symbolIndex(); idx != nil {
+		syms = idx.AtAddr(addr)
+	} else {
+		for _, sym := range f.Symtab.Syms {
+			if sym.Value == addr {
+				syms = append(syms, sym)
+			}
 		}
 	}
 	if len(syms) > 0 {
@@ -6,14 +6,19 @@ package macho
 
 import (
 	"bytes"
+	"encoding/binary"
 	"fmt"
 	"io"
 	"os"
 	"reflect"
+	"strings"
+	"sync"
 	"testing"
 
 	"github.com/blacktop/go-macho/internal/obscuretestdata"
+	"github.com/blacktop/go-macho/pkg/fixupchains"
 	"github.com/blacktop/go-macho/types"
+	"github.com/blacktop/go-macho/types/objc"
 )
 
 type fileTest struct {
@@ -43,11 +48,11 @@ var fileTests = []fileTest{
 			&Dylib{nil, types.DylibCmd{}, "/usr/lib/libSystem.B.dylib", 0x2, "0x6f0104", "0x10000"},
 		},
 		[]*SectionHeader{
-			{"__text", "__TEXT", 0x1f68, 0x88, 0xf68, 0x2, 0x0, 0x0, 0x80000400, 0, 0, 0},
-			{"__cstring", "__TEXT", 0x1ff0, 0xd, 0xff0, 0x0, 0x0, 0x0, 0x2, 0, 0, 0},
-			{"__data", "__DATA", 0x2000, 0x14, 0x1000, 0x2, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__dyld", "__DATA", 0x2014, 0x1c, 0x1014, 0x2, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__jump_table", "__IMPORT", 0x3000, 0xa, 0x2000, 0x6, 0x0, 0x0, 0x4000008, 0, 0, 0},
+			{"__text", "__TEXT", 0x1f68, 0x88, 0xf68, 0x2, 0x0, 0x0, 0x80000400, 0, 0, 0, 32},
+			{"__cstring", "__TEXT", 0x1ff0, 0xd, 0xff0, 0x0, 0x0, 0x0, 0x2, 0, 0, 0, 32},
+			{"__data", "__DATA", 0x2000, 0x14, 0x1000, 0x2, 0x0, 0x0, 0x0, 0, 0, 0, 32},
+			{"__dyld", "__DATA", 0x2014, 0x1c, 0x1014, 0x2, 0x0, 0x0, 0x0, 0, 0, 0, 32},
+			{"__jump_table", "__IMPORT", 0x3000, 0xa, 0x2000, 0x6, 0x0, 0x0, 0x4000008, 0, 0, 0, 32},
 		},
 		nil,
 	},
@@ -68,14 +73,14 @@ var fileTests = []fileTest{
 			&Dylib{nil, types.DylibCmd{}, "/usr/lib/libSystem.B.dylib", 0x2, "0x6f0104", "0x10000"},
 		},
 		[]*SectionHeader{
-			{"__text", "__TEXT", 0x100000f14, 0x6d, 0xf14, 0x2, 0x0, 0x0, 0x80000400, 0, 0, 0},
-			{"__symbol_stub1", "__TEXT", 0x100000f81, 0xc, 0xf81, 0x0, 0x0, 0x0, 0x80000408, 0, 0, 0},
-			{"__stub_helper", "__TEXT", 0x100000f90, 0x18, 0xf90, 0x2, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__cstring", "__TEXT", 0x100000fa8, 0xd, 0xfa8, 0x0, 0x0, 0x0, 0x2, 0, 0, 0},
-			{"__eh_frame", "__TEXT", 0x100000fb8, 0x48, 0xfb8, 0x3, 0x0, 0x0, 0x6000000b, 0, 0, 0},
-			{"__data", "__DATA", 0x100001000, 0x1c, 0x1000, 0x3, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__dyld", "__DATA", 0x100001020, 0x38, 0x1020, 0x3, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__la_symbol_ptr", "__DATA", 0x100001058, 0x10, 0x1058, 0x2, 0x0, 0x0, 0x7, 0, 0, 0},
+			{"__text", "__TEXT", 0x100000f14, 0x6d, 0xf14, 0x2, 0x0, 0x0, 0x80000400, 0, 0, 0, 64},
+			{"__symbol_stub1", "__TEXT", 0x100000f81, 0xc, 0xf81, 0x0, 0x0, 0x0, 0x80000408, 0, 0, 0, 64},
+			{"__stub_helper", "__TEXT", 0x100000f90, 0x18, 0xf90, 0x2, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__cstring", "__TEXT", 0x100000fa8, 0xd, 0xfa8, 0x0, 0x0, 0x0, 0x2, 0, 0, 0, 64},
+			{"__eh_frame", "__TEXT", 0x100000fb8, 0x48, 0xfb8, 0x3, 0x0, 0x0, 0x6000000b, 0, 0, 0, 64},
+			{"__data", "__DATA", 0x100001000, 0x1c, 0x1000, 0x3, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__dyld", "__DATA", 0x100001020, 0x38, 0x1020, 0x3, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__la_symbol_ptr", "__DATA", 0x100001058, 0x10, 0x1058, 0x2, 0x0, 0x0, 0x7, 0, 0, 0, 64},
 		},
 		nil,
 	},
@@ -89,21 +94,21 @@ var fileTests = []fileTest{
 			&SegmentHeader{types.LC_SEGMENT_64, 0x278, "__DWARF", 0x100002000, 0x1000, 0x1000, 0x1bc, 0x7, 0x3, 0x7, 0x0, 0},
 		},
 		[]*SectionHeader{
-			{"__text", "__TEXT", 0x100000f14, 0x0, 0x0, 0x2, 0x0, 0x0, 0x80000400, 0, 0, 0},
-			{"__symbol_stub1", "__TEXT", 0x100000f81, 0x0, 0x0, 0x0, 0x0, 0x0, 0x80000408, 0, 0, 0},
-			{"__stub_helper", "__TEXT", 0x100000f90, 0x0, 0x0, 0x2, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__cstring", "__TEXT", 0x100000fa8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2, 0, 0, 0},
-			{"__eh_frame", "__TEXT", 0x100000fb8, 0x0, 0x0, 0x3, 0x0, 0x0, 0x6000000b, 0, 0, 0},
-			{"__data", "__DATA", 0x100001000, 0x0, 0x0, 0x3, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__dyld", "__DATA", 0x100001020, 0x0, 0x0, 0x3, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__la_symbol_ptr", "__DATA", 0x100001058, 0x0, 0x0, 0x2, 0x0, 0x0, 0x7, 0, 0, 0},
-			{"__debug_abbrev", "__DWARF", 0x100002000, 0x36, 0x1000, 0x0, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__debug_aranges", "__DWARF", 0x100002036, 0x30, 0x1036, 0x0, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__debug_frame", "__DWARF", 0x100002066, 0x40, 0x1066, 0x0, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__debug_info", "__DWARF", 0x1000020a6, 0x54, 0x10a6, 0x0, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__debug_line", "__DWARF", 0x1000020fa, 0x47, 0x10fa, 0x0, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__debug_pubnames", "__DWARF", 0x100002141, 0x1b, 0x1141, 0x0, 0x0, 0x0, 0x0, 0, 0, 0},
-			{"__debug_str", "__DWARF", 0x10000215c, 0x60, 0x115c, 0x0, 0x0, 0x0, 0x0, 0, 0, 0},
+			{"__text", "__TEXT", 0x100000f14, 0x0, 0x0, 0x2, 0x0, 0x0, 0x80000400, 0, 0, 0, 64},
+			{"__symbol_stub1", "__TEXT", 0x100000f81, 0x0, 0x0, 0x0, 0x0, 0x0, 0x80000408, 0, 0, 0, 64},
+			{"__stub_helper", "__TEXT", 0x100000f90, 0x0, 0x0, 0x2, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__cstring", "__TEXT", 0x100000fa8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2, 0, 0, 0, 64},
+			{"__eh_frame", "__TEXT", 0x100000fb8, 0x0, 0x0, 0x3, 0x0, 0x0, 0x6000000b, 0, 0, 0, 64},
+			{"__data", "__DATA", 0x100001000, 0x0, 0x0, 0x3, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__dyld", "__DATA", 0x100001020, 0x0, 0x0, 0x3, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__la_symbol_ptr", "__DATA", 0x100001058, 0x0, 0x0, 0x2, 0x0, 0x0, 0x7, 0, 0, 0, 64},
+			{"__debug_abbrev", "__DWARF", 0x100002000, 0x36, 0x1000, 0x0, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__debug_aranges", "__DWARF", 0x100002036, 0x30, 0x1036, 0x0, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__debug_frame", "__DWARF", 0x100002066, 0x40, 0x1066, 0x0, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__debug_info", "__DWARF", 0x1000020a6, 0x54, 0x10a6, 0x0, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__debug_line", "__DWARF", 0x1000020fa, 0x47, 0x10fa, 0x0, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__debug_pubnames", "__DWARF", 0x100002141, 0x1b, 0x1141, 0x0, 0x0, 0x0, 0x0, 0, 0, 0, 64},
+			{"__debug_str", "__DWARF", 0x10000215c, 0x60, 0x115c, 0x0, 0x0, 0x0, 0x0, 0, 0, 0, 64},
 		},
 		nil,
 	},
@@ -360,6 +365,554 @@ func TestOpenFailure(t *testing.T) {
 	}
 }
 
+func TestOpenMmap(t *testing.T) {
+	for _, name := range []string{
+		"internal/testdata/gcc-386-darwin-exec.base64",
+		"internal/testdata/gcc-amd64-darwin-exec.base64",
+		"internal/testdata/clang-amd64-darwin-exec-with-rpath.base64",
+	} {
+		path, err := obscuretestdata.DecodeToTempFile(name)
+		if err != nil {
+			t.Fatal(err)
+		}
+		defer os.Remove(path)
+
+		want, err := Open(path)
+		if err != nil {
+			t.Fatal(err)
+		}
+		defer want.Close()
+
+		got, err := OpenMmap(path)
+		if err != nil {
+			t.Fatalf("OpenMmap %s: %v", name, err)
+		}
+
+		if !reflect.DeepEqual(got.FileHeader, want.FileHeader) {
+			t.Errorf("OpenMmap %s:\n\thave %#v\n\twant %#v\n", name, got.FileHeader, want.FileHeader)
+		}
+		if want.Symtab != nil && !reflect.DeepEqual(got.Symtab.Syms, want.Symtab.Syms) {
+			t.Errorf("OpenMmap %s: symbols do not match Open", name)
+		}
+		for i, sec := range want.Sections {
+			wdat, _ := sec.Data()
+			gdat, _ := got.Sections[i].Data()
+			if !bytes.Equal(gdat, wdat) || !reflect.DeepEqual(got.Sections[i].Relocs, sec.Relocs) {
+				t.Errorf("OpenMmap %s: section %s.%s does not match Open", name, sec.Seg, sec.Name)
+			}
+		}
+		for i, seg := range want.Segments() {
+			wdat, _ := seg.Data()
+			gdat, _ := got.Segments()[i].Data()
+			if !bytes.Equal(gdat, wdat) {
+				t.Errorf("OpenMmap %s: segment %s does not match Open", name, seg.Name)
+			}
+		}
+
+		if err := got.Close(); err != nil {
+			t.Errorf("OpenMmap %s: Close: %v", name, err)
+		}
+	}
+}
+
+// synthSection is a section of a synthSegment
+type synthSection struct {
+	name           string
+	addr, size     uint64
+	offset         uint32
+	reloff, nreloc uint32
+}
+
+// synthSegment is an LC_SEGMENT_64 of a synthMachO
+type synthSegment struct {
+	name                        string
+	addr, memsz, offset, filesz uint64
+	sections                    []synthSection
+}
+
+// synthMachO writes hdr followed by the segments and then the raw load commands cmds to the start
+// of dat and returns it; hdr.NCommands and hdr.SizeCommands are filled in
+func synthMachO(dat []byte, hdr types.FileHeader, segs []synthSegment, cmds ...[]byte) []byte {
+	bo := binary.LittleEndian
+	var lc bytes.Buffer
+	for _, s := range segs {
+		var seg types.Segment64
+		seg.LoadCmd = types.LC_SEGMENT_64
+		seg.Len = uint32(binary.Size(seg) + len(s.sections)*binary.Size(types.Section64{}))
+		copy(seg.Name[:], s.name)
+		seg.Addr, seg.Memsz, seg.Offset, seg.Filesz = s.addr, s.memsz, s.offset, s.filesz
+		seg.Nsect = uint32(len(s.sections))
+		binary.Write(&lc, bo, seg)
+		for _, ss := range s.sections {
+			var sec types.Section64
+			copy(sec.Name[:], ss.name)
+			copy(sec.Seg[:], s.name)
+			sec.Addr, sec.Size, sec.Offset = ss.addr, ss.size, ss.offset
+			sec.Reloff, sec.Nreloc = ss.reloff, ss.nreloc
+			binary.Write(&lc, bo, sec)
+		}
+	}
+	for _, cmd := range cmds {
+		lc.Write(cmd)
+	}
+	hdr.NCommands = uint32(len(segs) + len(cmds))
+	hdr.SizeCommands = uint32(lc.Len())
+	var out bytes.Buffer
+	binary.Write(&out, bo, hdr)
+	out.Write(lc.Bytes())
+	copy(dat, out.Bytes())
+	return dat
+}
+
+func TestNewFileLazy(t *testing.T) {
+	for _, name := range []string{
+		"internal/testdata/gcc-amd64-darwin-exec.base64",
+		"internal/testdata/clang-amd64-darwin-exec-with-rpath.base64",
+	} {
+		ra, err := readerAtFromObscured(name)
+		if err != nil {
+			t.Fatal(err)
+		}
+		want, err := NewFile(ra)
+		if err != nil {
+			t.Fatal(err)
+		}
+		got, err := NewFile(ra, FileConfig{LazyLoad: true})
+		if err != nil {
+			t.Fatalf("NewFile(LazyLoad) %s: %v", name, err)
+		}
+
+		if got.UUID() == nil || got.UUID().ID != want.UUID().ID {
+			t.Errorf("NewFile(LazyLoad) %s: UUID does not match", name)
+		}
+		if got.Symtab.Syms != nil {
+			t.Errorf("NewFile(LazyLoad) %s: symbols were decoded eagerly", name)
+		}
+
+		if err := got.ParseSymtab(); err != nil {
+			t.Fatal(err)
+		}
+		if err := got.ParseDysymtab(); err != nil {
+			t.Fatal(err)
+		}
+		if err := got.ParseRelocs(); err != nil {
+			t.Fatal(err)
+		}
+		if !reflect.DeepEqual(got.Symtab.Syms, want.Symtab.Syms) {
+			t.Errorf("NewFile(LazyLoad) %s: symbols do not match", name)
+		}
+		if !reflect.DeepEqual(got.Dysymtab.IndirectSyms, want.Dysymtab.IndirectSyms) {
+			t.Errorf("NewFile(LazyLoad) %s: indirect symbols do not match", name)
+		}
+	}
+
+	// PutRelocs decodes deferred relocations itself
+	bo := binary.LittleEndian
+	dat := synthMachO(make([]byte, 0x1000), types.FileHeader{Magic: types.Magic64, CPU: types.CPUAmd64, Type: types.Obj}, []synthSegment{{
+		name: "__TEXT", addr: 0x100000000, memsz: 0x1000, filesz: 0x1000,
+		sections: []synthSection{{name: "__text", addr: 0x100000400, size: 0x100, offset: 0x400, reloff: 0x800, nreloc: 2}},
+	}})
+	// a pc relative extern call and a 64 bit pointer
+	bo.PutUint32(dat[0x800:], 0x10)
+	bo.PutUint32(dat[0x804:], 3|1<<24|2<<25|1<<27|2<<28)
+	bo.PutUint32(dat[0x808:], 0x20)
+	bo.PutUint32(dat[0x80c:], 1|3<<25)
+
+	want, err := NewFile(bytes.NewReader(dat))
+	if err != nil {
+		t.Fatal(err)
+	}
+	got, err := NewFile(bytes.NewReader(dat), FileConfig{LazyLoad: true})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(want.Sections[0].Relocs) != 2 || got.Sections[0].Relocs != nil {
+		t.Fatalf("NewFile decoded %d relocations eagerly, NewFile(LazyLoad) %d; want 2 and 0", len(want.Sections[0].Relocs), len(got.Sections[0].Relocs))
+	}
+	gotBuf, wantBuf := make([]byte, 16), make([]byte, 16)
+	if n := got.Sections[0].PutRelocs(gotBuf, bo); n != 16 {
+		t.Errorf("NewFile(LazyLoad): PutRelocs wrote %d bytes of relocations; want 16", n)
+	}
+	want.Sections[0].PutRelocs(wantBuf, bo)
+	if !bytes.Equal(gotBuf, wantBuf) || !bytes.Equal(gotBuf, dat[0x800:0x810]) {
+		t.Errorf("NewFile(LazyLoad): PutRelocs wrote % x; want % x", gotBuf, dat[0x800:0x810])
+	}
+}
+
+func TestSymbolIndex(t *testing.T) {
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		t.Fatal(err)
+	}
+	var want []uint64
+	for _, sym := range f.Symtab.Syms {
+		addr, err := f.FindSymbolAddress(strings.ToUpper(sym.Name))
+		if err != nil {
+			t.Fatal(err)
+		}
+		want = append(want, addr)
+	}
+
+	idx, err := f.IndexSymbols()
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i, sym := range f.Symtab.Syms {
+		addr, err := f.FindSymbolAddress(strings.ToUpper(sym.Name))
+		if err != nil {
+			t.Fatal(err)
+		}
+		if addr != want[i] {
+			t.Errorf("FindSymbolAddress(%q) = %#x; want %#x", sym.Name, addr, want[i])
+		}
+		if got, ok := idx.Lookup(sym.Name); !ok || got.Name != sym.Name {
+			t.Errorf("Lookup(%q) = %v, %t", sym.Name, got, ok)
+		}
+		syms, err := f.FindAddressSymbols(sym.Value)
+		if err != nil {
+			t.Fatal(err)
+		}
+		var n int
+		for _, s := range f.Symtab.Syms {
+			if s.Value == sym.Value {
+				if s != syms[n] {
+					t.Errorf("FindAddressSymbols(%#x)[%d] = %v; want %v", sym.Value, n, syms[n], s)
+				}
+				n++
+			}
+		}
+		if n != len(syms) {
+			t.Errorf("FindAddressSymbols(%#x) returned %d symbols; want %d", sym.Value, len(syms), n)
+		}
+		if sym.Type.IsDefinedInSection() && !sym.Type.IsDebugSym() {
+			near, off, err := f.FindNearestSymbol(sym.Value + 1)
+			if err != nil {
+				t.Fatal(err)
+			}
+			if near.Value != sym.Value || off != 1 {
+				t.Errorf("FindNearestSymbol(%#x) = %s+%d", sym.Value+1, near.Name, off)
+			}
+		}
+	}
+	if _, _, err := f.FindNearestSymbol(0); err == nil {
+		t.Error("FindNearestSymbol(0) should fail")
+	}
+}
+
+func TestAddrIndex(t *testing.T) {
+	for _, name := range []string{
+		"internal/testdata/gcc-386-darwin-exec.base64",
+		"internal/testdata/gcc-amd64-darwin-exec.base64",
+		"internal/testdata/gcc-amd64-darwin-exec-debug.base64",
+		"internal/testdata/clang-amd64-darwin-exec-with-rpath.base64",
+	} {
+		f, err := openObscured(name)
+		if err != nil {
+			t.Fatal(err)
+		}
+		var probes []uint64
+		for _, seg := range f.Segments() {
+			probes = append(probes, seg.Addr, seg.Addr+seg.Memsz-1, seg.Addr+seg.Memsz, seg.Offset, seg.Offset+seg.Filesz)
+		}
+		for _, sec := range f.Sections {
+			probes = append(probes, sec.Addr, sec.Addr+sec.Size-1, sec.Addr+sec.Size)
+		}
+		type result struct {
+			off, addr uint64
+			offErr    bool
+			addrErr   bool
+			seg       *Segment
+			sec       *Section
+		}
+		lookup := func(p uint64) result {
+			var r result
+			var err error
+			r.off, err = f.GetOffset(p)
+			r.offErr = err != nil
+			r.addr, err = f.GetVMAddress(p)
+			r.addrErr = err != nil
+			r.seg = f.FindSegmentForVMAddr(p)
+			r.sec = f.FindSectionForVMAddr(p)
+			return r
+		}
+		got := make([]result, len(probes))
+		for i, p := range probes {
+			got[i] = lookup(p)
+		}
+		f.addrs = nil // force the linear scan
+		for i, p := range probes {
+			if want := lookup(p); got[i] != want {
+				t.Errorf("%s: lookup(%#x) = %+v; want %+v", name, p, got[i], want)
+			}
+		}
+	}
+}
+
+func TestConcurrentReaders(t *testing.T) {
+	ra, err := readerAtFromObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		t.Fatal(err)
+	}
+	f, err := NewFile(ra, FileConfig{LazyLoad: true})
+	if err != nil {
+		t.Fatal(err)
+	}
+	want, err := NewFile(ra)
+	if err != nil {
+		t.Fatal(err)
+	}
+	cstr := want.Section("__TEXT", "__cstring")
+	wantStr, err := want.GetCStringAtOffset(int64(cstr.Offset))
+	if err != nil {
+		t.Fatal(err)
+	}
+	wantFuncs := want.GetFunctions()
+
+	const workers = 8
+	errs := make(chan error, workers)
+	for w := 0; w < workers; w++ {
+		go func() {
+			errs <- func() error {
+				for i := 0; i < 50; i++ {
+					s, err := f.GetCStringAtOffset(int64(cstr.Offset))
+					if err != nil {
+						return err
+					}
+					if s != wantStr {
+						return fmt.Errorf("GetCStringAtOffset = %q; want %q", s, wantStr)
+					}
+					for _, sym := range want.Symtab.Syms {
+						addr, err := f.FindSymbolAddress(sym.Name)
+						if err != nil {
+							return err
+						}
+						if want, _ := want.FindSymbolAddress(sym.Name); addr != want {
+							return fmt.Errorf("FindSymbolAddress(%s) = %#x; want %#x", sym.Name, addr, want)
+						}
+					}
+					if fns := f.GetFunctions(); !reflect.DeepEqual(fns, wantFuncs) {
+						return fmt.Errorf("GetFunctions = %v; want %v", fns, wantFuncs)
+					}
+					for _, sec := range f.Sections {
+						if _, err := sec.Data(); err != nil {
+							return err
+						}
+					}
+					if err := f.ParseRelocs(); err != nil {
+						return err
+					}
+				}
+				return nil
+			}()
+		}()
+	}
+	for w := 0; w < workers; w++ {
+		if err := <-errs; err != nil {
+			t.Error(err)
+		}
+	}
+}
+
+func TestCStrings(t *testing.T) {
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		t.Fatal(err)
+	}
+	sec := f.Section("__TEXT", "__cstring")
+	dat, err := sec.Data()
+	if err != nil {
+		t.Fatal(err)
+	}
+	var offs []int64
+	var want []string
+	for off := 0; off < len(dat); off++ {
+		offs = append(offs, int64(sec.Offset)+int64(off))
+		want = append(want, cstring(dat[off:]))
+	}
+	check := func(mode string) {
+		for i, off := range offs {
+			s, err := f.GetCStringAtOffset(off)
+			if err != nil {
+				t.Fatalf("%s: GetCStringAtOffset(%#x): %v", mode, off, err)
+			}
+			if s != want[i] {
+				t.Errorf("%s: GetCStringAtOffset(%#x) = %q; want %q", mode, off, s, want[i])
+			}
+		}
+	}
+	check("uncached")
+	check("cached")
+	f.cstrs.strs = nil
+	if err := f.IndexCStrings(); err != nil {
+		t.Fatal(err)
+	}
+	check("tables")
+	if len(f.cstrs.strs) != 0 {
+		t.Errorf("IndexCStrings: %d strings were read from the file", len(f.cstrs.strs))
+	}
+}
+
+// synthSymtab builds a little-endian 64-bit symbol table with n entries
+// synthFunctionStarts returns LC_FUNCTION_STARTS data for n functions of 16 bytes starting at __TEXT+0xf60
+func synthFunctionStarts(n int) []byte {
+	data := []byte{0xe0, 0x1e} // ULEB128 0xf60
+	for i := 0; i < n; i++ {
+		data = append(data, 0x10)
+	}
+	return append(data, 0, 0, 0)
+}
+
+func TestFunctionStarts(t *testing.T) {
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		t.Fatal(err)
+	}
+	funcs := f.GetFunctions(synthFunctionStarts(1000)...)
+	if len(funcs) != 1000 {
+		t.Fatalf("GetFunctions returned %d functions; want 1000", len(funcs))
+	}
+
+	var addrs []uint64
+	for addr := funcs[0].StartAddr - 8; addr < funcs[len(funcs)-1].EndAddr+32; addr += 6 {
+		addrs = append(addrs, addr)
+	}
+	idxs, err := f.FindFunctionsForVMAddrs(addrs)
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i, addr := range addrs {
+		want := -1
+		for j, fn := range funcs {
+			if addr >= fn.StartAddr && addr < fn.EndAddr {
+				want = j
+				break
+			}
+		}
+		fn, err := f.GetFunctionForVMAddr(addr)
+		if want < 0 {
+			if err == nil {
+				t.Errorf("GetFunctionForVMAddr(%#x) = %v; want error", addr, fn)
+			}
+		} else if err != nil || fn != funcs[want] {
+			t.Errorf("GetFunctionForVMAddr(%#x) = %v, %v; want %v", addr, fn, err, funcs[want])
+		}
+		if idxs[i] != want {
+			t.Errorf("FindFunctionsForVMAddrs: %#x -> %d; want %d", addr, idxs[i], want)
+		}
+	}
+
+	if _, err := f.FindFunctionsForVMAddrs([]uint64{2, 1}); err == nil {
+		t.Error("FindFunctionsForVMAddrs of unsorted addrs did not fail")
+	}
+}
+
+func TestFunctionTable(t *testing.T) {
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		t.Fatal(err)
+	}
+	funcs := f.GetFunctions(synthFunctionStarts(100)...)
+	ft, err := f.GetFunctionTable()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if ft.Len() != len(funcs) {
+		t.Fatalf("GetFunctionTable has %d functions; want %d", ft.Len(), len(funcs))
+	}
+	var named int
+	for _, fn := range funcs {
+		for _, sym := range f.Symtab.Syms {
+			if sym.Value == fn.StartAddr && sym.Type.IsDefinedInSection() && !sym.Type.IsDebugSym() {
+				fn.Name = sym.Name
+				named++
+				break
+			}
+		}
+		got, ok := ft.Lookup(fn.StartAddr + 1)
+		if !ok || got != fn {
+			t.Errorf("FunctionTable.Lookup(%#x) = %v, %v; want %v", fn.StartAddr+1, got, ok, fn)
+		}
+	}
+	if named == 0 {
+		t.Error("no function was named")
+	}
+}
+
+func BenchmarkGetFunctionForVMAddr(b *testing.B) {
+	const nfuncs = 100000
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		b.Fatal(err)
+	}
+	funcs := f.GetFunctions(synthFunctionStarts(nfuncs)...)
+	b.Run("single", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := f.GetFunctionForVMAddr(funcs[i%len(funcs)].StartAddr + 4); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("batch", func(b *testing.B) {
+		addrs := make([]uint64, len(funcs))
+		for i, fn := range funcs {
+			addrs[i] = fn.StartAddr + 4
+		}
+		b.ReportAllocs()
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			if _, err := f.FindFunctionsForVMAddrs(addrs); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
+
+func synthSymtab(n int) (symdat, strtab []byte) {
+	symdat = make([]byte, n*16)
+	strtab = []byte{' ', 0}
+	for i := 0; i < n; i++ {
+		nl := types.Nlist64{
+			Nlist: types.Nlist{
+				Name: uint32(len(strtab)),
+				Type: types.N_SECT | types.N_EXT,
+				Sect: 1,
+			},
+			Value: 0x100000000 + uint64(i)*0x10,
+		}
+		nl.Put64(symdat[i*16:], binary.LittleEndian)
+		strtab = append(strtab, fmt.Sprintf("_sym%d", i)...)
+		strtab = append(strtab, 0)
+	}
+	return symdat, strtab
+}
+
+func BenchmarkNlist64Get(b *testing.B) {
+	symdat, _ := synthSymtab(10000)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		var n types.Nlist64
+		for off := 0; off < len(symdat); off += 16 {
+			n.Get64(symdat[off:], binary.LittleEndian)
+		}
+	}
+}
+
+func BenchmarkParseSymtab(b *testing.B) {
+	const nsyms = 10000
+	symdat, strtab := synthSymtab(nsyms)
+	f := &File{FileTOC: FileTOC{FileHeader: types.FileHeader{Magic: types.Magic64}, ByteOrder: binary.LittleEndian}}
+	hdr := &types.SymtabCmd{Nsyms: nsyms}
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := f.parseSymtab(symdat, strtab, nil, hdr, 0); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
 func TestOpenFat(t *testing.T) {
 	ff, err := openFatObscured("internal/testdata/fat-gcc-386-amd64-darwin-exec.base64")
 	if err != nil {
@@ -387,6 +940,180 @@ func TestOpenFat(t *testing.T) {
 	}
 }
 
+func TestFatFileLazy(t *testing.T) {
+	ra, err := readerAtFromObscured("internal/testdata/fat-gcc-386-amd64-darwin-exec.base64")
+	if err != nil {
+		t.Fatal(err)
+	}
+	want, err := NewFatFile(ra)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	lazy, err := NewFatFile(ra, FatFileConfig{LazyArches: true})
+	if err != nil {
+		t.Fatal(err)
+	}
+	parallel, err := NewFatFile(ra, FatFileConfig{Parallel: true})
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i := range want.Arches {
+		if lazy.Arches[i].File != nil {
+			t.Errorf("lazy architecture #%d was parsed before Open", i)
+		}
+		f, err := lazy.Arches[i].Open()
+		if err != nil {
+			t.Fatal(err)
+		}
+		if again, _ := lazy.Arches[i].Open(); again != f {
+			t.Errorf("FatArch.Open parsed architecture #%d twice", i)
+		}
+		if f.FileHeader != want.Arches[i].FileHeader || len(f.Loads) != len(want.Arches[i].Loads) {
+			t.Errorf("lazy architecture #%d differs from NewFatFile", i)
+		}
+		if f := parallel.Arches[i].File; f == nil || f.FileHeader != want.Arches[i].FileHeader {
+			t.Errorf("parallel architecture #%d differs from NewFatFile", i)
+		}
+	}
+
+	f, err := lazy.OpenArch(types.CPUAmd64)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if f.CPU != types.CPUAmd64 {
+		t.Errorf("OpenArch(%s) returned a %s file", types.CPUAmd64, f.CPU)
+	}
+}
+
+func TestScan(t *testing.T) {
+	var paths []string
+	for _, name := range []string{
+		"internal/testdata/gcc-386-darwin-exec.base64",
+		"internal/testdata/clang-amd64-darwin-exec-with-rpath.base64",
+		"internal/testdata/fat-gcc-386-amd64-darwin-exec.base64",
+	} {
+		path, err := obscuretestdata.DecodeToTempFile(name)
+		if err != nil {
+			t.Fatal(err)
+		}
+		defer os.Remove(path)
+		paths = append(paths, path)
+	}
+	paths = append(paths, "file.go", "does-not-exist")
+
+	for _, opts := range []ScanOptions{
+		{},
+		{Workers: 3, MaxMemory: 1, Mmap: true},
+		{Workers: 4, MaxOpenFiles: 2, FileConfig: FileConfig{LazyLoad: true}},
+	} {
+		var mu sync.Mutex
+		seen := make(map[string]int)
+		results, err := Scan(paths, opts, func(path string, f *File) error {
+			if len(f.Loads) == 0 {
+				return fmt.Errorf("%s has no load commands", path)
+			}
+			mu.Lock()
+			seen[path]++
+			mu.Unlock()
+			return nil
+		})
+		if err != nil {
+			t.Fatal(err)
+		}
+		if len(results) != len(paths) {
+			t.Fatalf("Scan returned %d results; want %d", len(results), len(paths))
+		}
+		for i, want := range []ScanResult{
+			{Files: 1}, {Files: 1}, {Files: 2, Fat: true}, {Skipped: true}, {},
+		} {
+			res := results[i]
+			if res.Path != paths[i] || res.Files != want.Files || res.Fat != want.Fat || res.Skipped != want.Skipped || seen[paths[i]] != want.Files {
+				t.Errorf("Scan(%+v) result #%d = %+v; want %+v", opts, i, res, want)
+			}
+			if (res.Err != nil) != (i == len(paths)-1) {
+				t.Errorf("Scan(%+v) %s error = %v", opts, res.Path, res.Err)
+			}
+		}
+	}
+}
+
+// synthFileSet returns a MH_FILESET with n entries, each an empty MH_KEXT_BUNDLE
+func synthFileSet(n int) []byte {
+	bo := binary.LittleEndian
+	cmds := make([][]byte, n)
+	for i := range cmds {
+		name := fmt.Sprintf("com.apple.kext.k%d\x00", i)
+		size := (32 + len(name) + 7) &^ 7
+		var cmd bytes.Buffer
+		binary.Write(&cmd, bo, types.FilesetEntryCmd{
+			LoadCmd: types.LC_FILESET_ENTRY,
+			Len:     uint32(size),
+			Addr:    0xfffffe0007004000 + uint64(i+1)*0x1000,
+			Offset:  uint64(i+1) * 0x1000,
+			EntryID: 32,
+		})
+		cmd.WriteString(name)
+		cmd.Write(make([]byte, size-32-len(name)))
+		cmds[i] = cmd.Bytes()
+	}
+	dat := synthMachO(make([]byte, (n+1)*0x1000+32), types.FileHeader{Magic: types.Magic64, CPU: types.CPUArm64, Type: types.FileSet}, nil, cmds...)
+	for i := 0; i < n; i++ {
+		synthMachO(dat[(i+1)*0x1000:], types.FileHeader{Magic: types.Magic64, CPU: types.CPUArm64, Type: types.KextBundle, Reserved: uint32(i)}, nil)
+	}
+	return dat
+}
+
+func TestFileSet(t *testing.T) {
+	const n = 40
+	f, err := NewFile(bytes.NewReader(synthFileSet(n)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if got := len(f.FileSets()); got != n {
+		t.Fatalf("FileSets returned %d entries; want %d", got, n)
+	}
+
+	m, err := f.GetFileSetFile("com.apple.kext.k7")
+	if err != nil {
+		t.Fatal(err)
+	}
+	if m.Type != types.KextBundle || m.Reserved != 7 {
+		t.Errorf("GetFileSetFile(com.apple.kext.k7) returned the wrong entry: %v", m.FileHeader)
+	}
+	if again, _ := f.GetFileSetFile("com.apple.kext.k7"); again != m {
+		t.Error("GetFileSetFile parsed the entry twice")
+	}
+	if byName, _ := f.GetFileSetFileByName("com.apple.kext.k1"); byName == nil || byName.Reserved != 1 {
+		t.Error("GetFileSetFileByName did not prefer the exact entry id")
+	}
+	if byName, _ := f.GetFileSetFileByName("KEXT.K39"); byName == nil || byName.Reserved != 39 {
+		t.Error("GetFileSetFileByName did not find a case insensitive substring")
+	}
+	if _, err := f.GetFileSetFile("com.apple.kext"); err == nil {
+		t.Error("GetFileSetFile matched a partial entry id")
+	}
+
+	var mu sync.Mutex
+	seen := make(map[string]*File)
+	if err := f.ForEachFileSetEntry(4, func(fs *FilesetEntry, m *File) error {
+		mu.Lock()
+		seen[fs.EntryID] = m
+		mu.Unlock()
+		return nil
+	}); err != nil {
+		t.Fatal(err)
+	}
+	if len(seen) != n || seen["com.apple.kext.k7"] != m {
+		t.Errorf("ForEachFileSetEntry visited %d entries (k7 cached: %v); want %d", len(seen), seen["com.apple.kext.k7"] == m, n)
+	}
+
+	errStop := fmt.Errorf("stop")
+	if err := f.ForEachFileSetEntry(2, func(*FilesetEntry, *File) error { return errStop }); err != errStop {
+		t.Errorf("ForEachFileSetEntry returned %v; want the callback error", err)
+	}
+}
+
 func TestOpenFatFailure(t *testing.T) {
 	filename := "file.go" // not a Mach-O file
 	if _, err := OpenFat(filename); err == nil {
@@ -463,3 +1190,518 @@ func TestNewFile(t *testing.T) {
 		t.Errorf("macho.UUID() = %s; want test", got.UUID())
 	}
 }
+
+func BenchmarkFindNearestSymbol(b *testing.B) {
+	const nsyms = 100000
+	symdat, strtab := synthSymtab(nsyms)
+	f := &File{FileTOC: FileTOC{FileHeader: types.FileHeader{Magic: types.Magic64}, ByteOrder: binary.LittleEndian}}
+	st, err := f.parseSymtab(symdat, strtab, nil, &types.SymtabCmd{Nsyms: nsyms}, 0)
+	if err != nil {
+		b.Fatal(err)
+	}
+	f.Symtab = st
+	if _, err := f.IndexSymbols(); err != nil {
+		b.Fatal(err)
+	}
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, _, err := f.FindNearestSymbol(0x100000000 + uint64(i%nsyms)*0x10 + 4); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkGetOffset(b *testing.B) {
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		b.Fatal(err)
+	}
+	text := f.Segment("__TEXT")
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := f.GetOffset(text.Addr + uint64(i)%text.Memsz); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkFindSectionForVMAddr(b *testing.B) {
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		b.Fatal(err)
+	}
+	last := f.Sections[len(f.Sections)-1]
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if f.FindSectionForVMAddr(last.Addr) == nil {
+			b.Fatal("section not found")
+		}
+	}
+}
+
+func BenchmarkGetCStringAtOffset(b *testing.B) {
+	f, err := openObscured("internal/testdata/clang-amd64-darwin-exec-with-rpath.base64")
+	if err != nil {
+		b.Fatal(err)
+	}
+	sec := f.Section("__TEXT", "__cstring")
+	b.Run("cache", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := f.GetCStringAtOffset(int64(sec.Offset) + int64(uint64(i)%sec.Size)); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	if err := f.IndexCStrings(); err != nil {
+		b.Fatal(err)
+	}
+	b.Run("tables", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := f.GetCStringAtOffset(int64(sec.Offset) + int64(uint64(i)%sec.Size)); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
+
+// synthObjC builds an arm64 MachO holding n ObjC classes; class i subclasses class i-1 (class 0 is a root)
+// and has the instance methods m<i> and init and the class method c<i>, all in small method lists;
+// the classes are also referenced from __objc_classrefs and __objc_superrefs
+func synthObjC(n int) []byte {
+	return synthObjCWithFixups(n, nil)
+}
+
+// synthObjCWithFixups is synthObjC with an LC_DYLD_CHAINED_FIXUPS whose payload (in __LINKEDIT) is chained
+func synthObjCWithFixups(n int, chained []byte) []byte {
+	const (
+		base    = 0x100000000
+		dataOff = 0x1000
+	)
+	bo := binary.LittleEndian
+	var dat bytes.Buffer
+	dat.Write(make([]byte, dataOff))
+	vmaddr := func() uint64 { return base + uint64(dat.Len()) }
+	type sect struct {
+		seg, name string
+		addr, end uint64
+	}
+	var sects []sect
+	begin := func(seg, name string) { sects = append(sects, sect{seg: seg, name: name, addr: vmaddr()}) }
+	end := func() {
+		dat.Write(make([]byte, -dat.Len()&7))
+		sects[len(sects)-1].end = vmaddr()
+	}
+
+	cstr := func(s string) uint64 {
+		addr := vmaddr()
+		dat.WriteString(s + "\x00")
+		return addr
+	}
+	begin("__TEXT", "__objc_methname")
+	typeStr := cstr("v16@0:8")
+	var selNames []uint64
+	sel := func(s string) int {
+		selNames = append(selNames, cstr(s))
+		return len(selNames) - 1
+	}
+	initSel := sel("init")
+	classNames := make([]uint64, n)
+	instSels := make([][2]int, n)
+	classSels := make([]int, n)
+	for i := 0; i < n; i++ {
+		classNames[i] = cstr(fmt.Sprintf("Class%d", i))
+		instSels[i] = [2]int{sel(fmt.Sprintf("m%d", i)), initSel}
+		classSels[i] = sel(fmt.Sprintf("c%d", i))
+	}
+	end()
+
+	// the selector reference offsets are patched in once __objc_selrefs is laid out
+	type selFixup struct{ pos, sel int }
+	var fixups []selFixup
+	begin("__TEXT", "__objc_methlist")
+	rel := func(target uint64) int32 { return int32(int64(target) - int64(vmaddr())) }
+	methodList := func(sels ...int) uint64 {
+		addr := vmaddr()
+		binary.Write(&dat, bo, objc.MethodList{EntSizeAndFlags: objc.METHOD_LIST_SMALL | objc.MethodSmallTSize, Count: uint32(len(sels))})
+		for _, s := range sels {
+			fixups = append(fixups, selFixup{dat.Len(), s})
+			binary.Write(&dat, bo, int32(0))
+			binary.Write(&dat, bo, rel(typeStr))
+			binary.Write(&dat, bo, rel(base))
+		}
+		dat.Write(make([]byte, -dat.Len()&7))
+		return addr
+	}
+	instLists := make([]uint64, n)
+	classLists := make([]uint64, n)
+	for i := 0; i < n; i++ {
+		instLists[i] = methodList(instSels[i][0], instSels[i][1])
+		classLists[i] = methodList(classSels[i])
+	}
+	end()
+	textEnd := dat.Len()
+
+	begin("__DATA", "__objc_selrefs")
+	selRefs := vmaddr()
+	binary.Write(&dat, bo, selNames)
+	end()
+	for _, fx := range fixups {
+		bo.PutUint32(dat.Bytes()[fx.pos:], uint32(int64(selRefs)+int64(fx.sel*8)-int64(base+uint64(fx.pos))))
+	}
+
+	begin("__DATA", "__objc_const")
+	classROs := make([]uint64, n)
+	metaROs := make([]uint64, n)
+	for i := 0; i < n; i++ {
+		var flags objc.ClassRoFlags
+		if i == 0 {
+			flags = objc.RO_ROOT
+		}
+		classROs[i] = vmaddr()
+		binary.Write(&dat, bo, objc.ClassRO64{Flags: flags, NameVMAddr: classNames[i], BaseMethodsVMAddr: instLists[i]})
+		metaROs[i] = vmaddr()
+		binary.Write(&dat, bo, objc.ClassRO64{Flags: flags | objc.RO_META, NameVMAddr: classNames[i], BaseMethodsVMAddr: classLists[i]})
+	}
+	end()
+
+	begin("__DATA", "__objc_data")
+	classSize := uint64(binary.Size(objc.SwiftClassMetadata64{}))
+	classes := make([]uint64, n)
+	for i := 0; i < n; i++ {
+		classes[i] = vmaddr()
+		meta := classes[i] + classSize
+		var super uint64
+		if i > 0 {
+			super = classes[i-1]
+		}
+		binary.Write(&dat, bo, objc.SwiftClassMetadata64{ObjcClass64: objc.ObjcClass64{IsaVMAddr: meta, SuperclassVMAddr: super, DataVMAddrAndFastFlags: classROs[i]}})
+		binary.Write(&dat, bo, objc.SwiftClassMetadata64{ObjcClass64: objc.ObjcClass64{DataVMAddrAndFastFlags: metaROs[i]}})
+	}
+	end()
+
+	begin("__DATA", "__objc_classlist")
+	binary.Write(&dat, bo, classes)
+	end()
+
+	// every class is referenced once and Class0 once more; each superclass is referenced by its subclass
+	begin("__DATA", "__objc_classrefs")
+	binary.Write(&dat, bo, append(classes[:n:n], classes[0]))
+	end()
+	begin("__DATA", "__objc_superrefs")
+	binary.Write(&dat, bo, classes[:n-1])
+	end()
+
+	segment := func(name string, start, stop int) synthSegment {
+		seg := synthSegment{name: name, addr: base + uint64(start), memsz: uint64(stop - start), offset: uint64(start), filesz: uint64(stop - start)}
+		for _, s := range sects {
+			if s.seg == name {
+				seg.sections = append(seg.sections, synthSection{name: s.name, addr: s.addr, size: s.end - s.addr, offset: uint32(s.addr - base)})
+			}
+		}
+		return seg
+	}
+	segs := []synthSegment{
+		segment("__TEXT", 0, textEnd),
+		segment("__DATA", textEnd, dat.Len()),
+	}
+	if chained == nil {
+		return synthMachO(dat.Bytes(), types.FileHeader{Magic: types.Magic64, CPU: types.CPUArm64, Type: types.Dylib}, segs)
+	}
+	linkedit := dat.Len()
+	dat.Write(chained)
+	segs = append(segs, synthSegment{name: "__LINKEDIT", addr: base + uint64(linkedit), memsz: uint64(len(chained)), offset: uint64(linkedit), filesz: uint64(len(chained))})
+	var cmd bytes.Buffer
+	binary.Write(&cmd, bo, types.DyldChainedFixupsCmd{LoadCmd: types.LC_DYLD_CHAINED_FIXUPS, Len: 16, Offset: uint32(linkedit), Size: uint32(len(chained))})
+	return synthMachO(dat.Bytes(), types.FileHeader{Magic: types.Magic64, CPU: types.CPUArm64, Type: types.Dylib}, segs, cmd.Bytes())
+}
+
+func TestObjCClassCache(t *testing.T) {
+	const n = 200
+	f, err := NewFile(bytes.NewReader(synthObjC(n)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	classes, err := f.GetObjCClasses()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(classes) != n {
+		t.Fatalf("GetObjCClasses returned %d classes; want %d", len(classes), n)
+	}
+	for i, c := range classes {
+		super := "<ROOT>"
+		if i > 0 {
+			super = classes[i-1].Name
+			if c.SuperclassVMAddr != classes[i-1].ClassPtr.VMAdder {
+				t.Errorf("%s: SuperclassVMAddr = %#x; want %#x", c.Name, c.SuperclassVMAddr, classes[i-1].ClassPtr.VMAdder)
+			}
+		}
+		if c.Name != fmt.Sprintf("Class%d", i) || c.SuperClass != super || c.Isa != c.Name {
+			t.Errorf("class %d: name=%s super=%s isa=%s; want Class%d, %s, Class%d", i, c.Name, c.SuperClass, c.Isa, i, super, i)
+		}
+		if len(c.InstanceMethods) != 2 || c.InstanceMethods[0].Name != fmt.Sprintf("m%d", i) || c.InstanceMethods[1].Name != "init" {
+			t.Errorf("%s: wrong instance methods %v", c.Name, c.InstanceMethods)
+		}
+		if len(c.ClassMethods) != 1 || c.ClassMethods[0].Name != fmt.Sprintf("c%d", i) {
+			t.Errorf("%s: wrong class methods %v", c.Name, c.ClassMethods)
+		}
+	}
+
+	// a fresh File so the workers parse the classes instead of reading them from the cache
+	pf, err := NewFile(bytes.NewReader(synthObjC(n)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	parallel, err := pf.GetObjCClassesParallel(8)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(parallel, classes) {
+		t.Error("GetObjCClassesParallel did not return the classes of GetObjCClasses in list order")
+	}
+
+	c, err := f.GetObjCClass(classes[n-1].ClassPtr.VMAdder)
+	if err != nil {
+		t.Fatal(err)
+	}
+	c.Name = "modified"
+	c.InstanceMethods[0].Name = "modified"
+	c.ClassMethods[0].Name = "modified"
+	again, _ := f.GetObjCClass(classes[n-1].ClassPtr.VMAdder)
+	if again.Name != classes[n-1].Name || again.InstanceMethods[0].Name != classes[n-1].InstanceMethods[0].Name || again.ClassMethods[0].Name != classes[n-1].ClassMethods[0].Name {
+		t.Error("modifying a returned class changed the cached class")
+	}
+}
+
+func TestObjCMethodTable(t *testing.T) {
+	const n = 100
+	f, err := NewFile(bytes.NewReader(synthObjC(n)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	mt, err := f.GetObjCMethodTable()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if mt.Len() != 3*n || len(mt.Lists) != 2*n {
+		t.Fatalf("GetObjCMethodTable returned %d methods in %d lists; want %d in %d", mt.Len(), len(mt.Lists), 3*n, 2*n)
+	}
+	classes, err := f.GetObjCClasses()
+	if err != nil {
+		t.Fatal(err)
+	}
+	// the lists are laid out as the instance then class methods of each class
+	for i, c := range classes {
+		for j, lst := range [][]objc.Method{c.InstanceMethods, c.ClassMethods} {
+			start := int(mt.Lists[2*i+j])
+			for k, want := range lst {
+				got := mt.Method(start + k)
+				if got.Name != want.Name || got.Types != want.Types || got.ImpVMAddr != want.ImpVMAddr {
+					t.Fatalf("method %d: got %s %s %#x; want %s %s %#x", start+k, got.Name, got.Types, got.ImpVMAddr, want.Name, want.Types, want.ImpVMAddr)
+				}
+			}
+		}
+	}
+	// "init" and the type encoding are shared by every class
+	if want := len("v16@0:8\x00init\x00") + n*len("m00\x00c00\x00"); len(mt.Strings) > want {
+		t.Errorf("string table is %d bytes; want at most %d", len(mt.Strings), want)
+	}
+	if mt.NameOffsets[1] != mt.NameOffsets[4] || mt.Name(1) != "init" {
+		t.Errorf("init was not interned: %d != %d", mt.NameOffsets[1], mt.NameOffsets[4])
+	}
+
+	// selector references and strings outside of this image's sections (as in the shared cache)
+	// are read through the reader
+	ext, err := NewFile(bytes.NewReader(synthObjC(n)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	ext.Section("__TEXT", "__objc_methname").Size = 0
+	ext.Section("__DATA", "__objc_selrefs").Size = 0
+	emt, err := ext.GetObjCMethodTable()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(emt, mt) {
+		t.Error("GetObjCMethodTable differs when the strings are not in a section")
+	}
+}
+
+func TestObjCMethodListOverflow(t *testing.T) {
+	f, err := NewFile(bytes.NewReader(synthObjC(2)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	methlist := f.Section("__TEXT", "__objc_methlist")
+
+	// counts whose entries wrap uint32 to a few bytes
+	for _, ml := range []objc.MethodList{
+		{EntSizeAndFlags: objc.METHOD_LIST_SMALL | objc.MethodSmallTSize, Count: 0x15555556},
+		{EntSizeAndFlags: objc.MethodTSize, Count: 0x0aaaaaab},
+	} {
+		dat := synthObjC(2)
+		binary.LittleEndian.PutUint32(dat[methlist.Offset:], ml.EntSizeAndFlags)
+		binary.LittleEndian.PutUint32(dat[methlist.Offset+4:], ml.Count)
+		bad, err := NewFile(bytes.NewReader(dat))
+		if err != nil {
+			t.Fatal(err)
+		}
+		if _, err := bad.GetObjCMethods(methlist.Addr); err == nil || !strings.Contains(err.Error(), "overflows") {
+			t.Errorf("GetObjCMethods(%s) = %v; want an overflow error", ml, err)
+		}
+		if ml.IsSmall() {
+			if _, err := bad.GetObjCMethodList(); err == nil || !strings.Contains(err.Error(), "overflows") {
+				t.Errorf("GetObjCMethodList(%s) = %v; want an overflow error", ml, err)
+			}
+		}
+	}
+}
+
+func TestObjCRefIndex(t *testing.T) {
+	const n = 50
+	f, err := NewFile(bytes.NewReader(synthObjC(n)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	x, err := f.GetObjCRefIndex()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if again, _ := f.GetObjCRefIndex(); again != x {
+		t.Error("GetObjCRefIndex built the index twice")
+	}
+	// 2n+1 selectors, n+1 class refs and n-1 super refs
+	if x.Len() != 4*n+1 {
+		t.Fatalf("index has %d refs; want %d", x.Len(), 4*n+1)
+	}
+
+	selRefs, err := f.GetObjCSelectorReferences()
+	if err != nil {
+		t.Fatal(err)
+	}
+	for addr, sel := range selRefs {
+		r, ok := x.Lookup(addr)
+		if !ok || r.Kind != ObjCSelRef || r.Name != sel.Name || r.Target != sel.VMAddr {
+			t.Errorf("Lookup(%#x) = %v, %t; want selector %s", addr, r, ok, sel.Name)
+		}
+		if sites := x.SelectorRefs(sel.Name); len(sites) != 1 || sites[0] != addr {
+			t.Errorf("SelectorRefs(%s) = %#x; want [%#x]", sel.Name, sites, addr)
+		}
+	}
+
+	clsRefs := f.Section("__DATA", "__objc_classrefs")
+	if sites := x.ClassRefs("Class0"); len(sites) != 2 || sites[0] != clsRefs.Addr || sites[1] != clsRefs.Addr+n*8 {
+		t.Errorf("ClassRefs(Class0) = %#x; want the first and last __objc_classrefs entries", sites)
+	}
+	superRefs := f.Section("__DATA", "__objc_superrefs")
+	if sites := x.Refs(ObjCSuperRef, "Class3"); len(sites) != 1 || sites[0] != superRefs.Addr+3*8 {
+		t.Errorf("Refs(ObjCSuperRef, Class3) = %#x; want [%#x]", sites, superRefs.Addr+3*8)
+	}
+	if sites := x.Refs(ObjCSuperRef, fmt.Sprintf("Class%d", n-1)); sites != nil {
+		t.Errorf("the last class has super refs %#x", sites)
+	}
+	if _, ok := x.Lookup(clsRefs.Addr + 1); ok {
+		t.Error("Lookup found a reference in the middle of an entry")
+	}
+
+	// unresolvable references are indexed without a name instead of failing the whole index
+	dat := synthObjC(n)
+	selRefs0 := f.Section("__DATA", "__objc_selrefs")
+	binary.LittleEndian.PutUint64(dat[selRefs0.Offset+8:], 0xdead0000)
+	binary.LittleEndian.PutUint64(dat[clsRefs.Offset+8:], 0xdead0000)
+	bad, err := NewFile(bytes.NewReader(dat))
+	if err != nil {
+		t.Fatal(err)
+	}
+	bx, err := bad.GetObjCRefIndex()
+	if err != nil {
+		t.Fatalf("GetObjCRefIndex with unresolvable refs: %v", err)
+	}
+	if bx.Len() != x.Len() {
+		t.Errorf("index with unresolvable refs has %d refs; want %d", bx.Len(), x.Len())
+	}
+	for _, addr := range []uint64{selRefs0.Addr + 8, clsRefs.Addr + 8} {
+		if r, ok := bx.Lookup(addr); !ok || r.Name != "" || r.Target != 0 {
+			t.Errorf("Lookup(%#x) = %v, %t; want an unresolved reference", addr, r, ok)
+		}
+	}
+	if r, _ := bx.Lookup(clsRefs.Addr); r.Name != "Class0" {
+		t.Errorf("Lookup(%#x) = %v; want Class0", clsRefs.Addr, r)
+	}
+
+	// arm64e binds to an import and to an ordinal past the imports
+	var fixups bytes.Buffer
+	binary.Write(&fixups, binary.LittleEndian, fixupchains.DyldChainedFixupsHeader{
+		StartsOffset:  28,
+		ImportsOffset: 32,
+		SymbolsOffset: 36,
+		ImportsCount:  1,
+		ImportsFormat: fixupchains.DC_IMPORT,
+	})
+	binary.Write(&fixups, binary.LittleEndian, uint32(0)) // no chained segments
+	binary.Write(&fixups, binary.LittleEndian, uint32(1)) // lib ordinal 1, name offset 0
+	fixups.WriteString("_OBJC_CLASS_$_NSObject\x00")
+	dat = synthObjCWithFixups(n, fixups.Bytes())
+	binary.LittleEndian.PutUint64(dat[clsRefs.Offset+8:], 1<<62)
+	binary.LittleEndian.PutUint64(dat[clsRefs.Offset+16:], 1<<62|0xffff)
+	bound, err := NewFile(bytes.NewReader(dat))
+	if err != nil {
+		t.Fatal(err)
+	}
+	bx, err = bound.GetObjCRefIndex()
+	if err != nil {
+		t.Fatalf("GetObjCRefIndex with bound refs: %v", err)
+	}
+	if r, ok := bx.Lookup(clsRefs.Addr + 8); !ok || r.Name != "NSObject" || r.Target != 0 {
+		t.Errorf("Lookup(%#x) = %v, %t; want a bind to NSObject", clsRefs.Addr+8, r, ok)
+	}
+	if r, ok := bx.Lookup(clsRefs.Addr + 16); !ok || r.Name != "" || r.Target != 0 {
+		t.Errorf("Lookup(%#x) = %v, %t; want an unresolved reference", clsRefs.Addr+16, r, ok)
+	}
+}
+
+func TestAddrIndexAfterExport(t *testing.T) {
+	// __DATA starts 0x3000 past the end of __TEXT in the file; Export packs it right after
+	dat := synthMachO(make([]byte, 0x5000), types.FileHeader{Magic: types.Magic64, CPU: types.CPUArm64, Type: types.Dylib}, []synthSegment{
+		{name: "__TEXT", addr: 0x100000000, memsz: 0x1000, offset: 0, filesz: 0x1000},
+		{name: "__DATA", addr: 0x100001000, memsz: 0x1000, offset: 0x4000, filesz: 0x1000},
+	})
+
+	f, err := NewFile(bytes.NewReader(dat))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if addr, err := f.GetVMAddress(0x4010); err != nil || addr != 0x100001010 {
+		t.Fatalf("GetVMAddress(0x4010) = %#x, %v; want 0x100001010", addr, err)
+	}
+
+	if err := f.Export(t.TempDir()+"/exported", nil, 0); err != nil {
+		t.Fatal(err)
+	}
+	if off := f.Segment("__DATA").Offset; off != 0x1000 {
+		t.Fatalf("Export moved __DATA to %#x; want 0x1000", off)
+	}
+	if addr, err := f.GetVMAddress(0x1010); err != nil || addr != 0x100001010 {
+		t.Errorf("GetVMAddress(0x1010) after Export = %#x, %v; want 0x100001010", addr, err)
+	}
+	if _, err := f.GetVMAddress(0x4010); err == nil {
+		t.Error("GetVMAddress(0x4010) still resolves the offset __DATA had before Export")
+	}
+
+	// edits to the indexed fields are seen without a rebuild
+	f.Segment("__DATA").Addr = 0x200000000
+	if addr, err := f.GetVMAddress(0x1010); err != nil || addr != 0x200000010 {
+		t.Errorf("GetVMAddress(0x1010) after moving __DATA = %#x, %v; want 0x200000010", addr, err)
+	}
+	if seg := f.FindSegmentForVMAddr(0x100001010); seg != nil {
+		t.Errorf("FindSegmentForVMAddr found %s at the address __DATA had before the edit", seg.Name)
+	}
+	if seg := f.FindSegmentForVMAddr(0x200000010); seg == nil || seg.Name != "__DATA" {
+		t.Errorf("FindSegmentForVMAddr(0x200000010) = %v; want __DATA", seg)
+	}
+}
@@ -0,0 +1,128 @@
+package macho
+
+import (
+	"fmt"
+	"io"
+	"runtime"
+	"strings"
+	"sync"
+	"sync/atomic"
+)
+
+// fileSetCache indexes the LC_FILESET_ENTRY loads and memoizes the Files parsed from them
+type fileSetCache struct {
+	once    sync.Once
+	entries []*fileSetEntry
+	byName  map[string]*fileSetEntry // EntryID -> first entry
+}
+
+// fileSetEntry is a fileset entry and its File once parsed
+type fileSetEntry struct {
+	*FilesetEntry
+	once sync.Once
+	file *File
+	err  error
+}
+
+// fileSetIndex builds (once) the fileset entry index
+func (f *File) fileSetIndex() *fileSetCache {
+	f.fsets.once.Do(func() {
+		f.fsets.byName = make(map[string]*fileSetEntry)
+		for _, l := range f.Loads {
+			if fs, ok := l.(*FilesetEntry); ok {
+				e := &fileSetEntry{FilesetEntry: fs}
+				f.fsets.entries = append(f.fsets.entries, e)
+				if _, ok := f.fsets.byName[fs.EntryID]; !ok {
+					f.fsets.byName[fs.EntryID] = e
+				}
+			}
+		}
+	})
+	return &f.fsets
+}
+
+// openFileSetEntry parses (once) the MachO of a fileset entry. It reads through the parent's
+// reader and translates addresses with the parent's segments, which span every entry.
+func (f *File) openFileSetEntry(e *fileSetEntry) (*File, error) {
+	e.once.Do(func() {
+		e.file, e.err = NewFile(io.NewSectionReader(f.sr, int64(e.Offset), 1<<63-1-int64(e.Offset)), FileConfig{
+			Offset:          int64(e.Offset),
+			SrcReader:       f.sr,
+			VMAddrConverter: *f.vma,
+		})
+	})
+	return e.file, e.err
+}
+
+// GetFileSetFile returns the Fileset MachO whose entry id is exactly entryID.
+// Entries are parsed once and the same *File is returned on later calls.
+func (f *File) GetFileSetFile(entryID string) (*File, error) {
+	if e, ok := f.fileSetIndex().byName[entryID]; ok {
+		return f.openFileSetEntry(e)
+	}
+	return nil, fmt.Errorf("fileset does NOT contain %s", entryID)
+}
+
+// ForEachFileSetEntry parses the fileset entries with up to workers goroutines (<= 0 means
+// runtime.NumCPU()) and calls fn with each entry and its MachO. fn is called concurrently.
+// The first error stops handing out new entries and is returned.
+func (f *File) ForEachFileSetEntry(workers int, fn func(*FilesetEntry, *File) error) error {
+	entries := f.fileSetIndex().entries
+	if workers <= 0 {
+		workers = runtime.NumCPU()
+	}
+	if workers > len(entries) {
+		workers = len(entries)
+	}
+
+	var next int64 = -1
+	var failed int32
+	errs := make([]error, len(entries))
+	var wg sync.WaitGroup
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for atomic.LoadInt32(&failed) == 0 {
+				i := int(atomic.AddInt64(&next, 1))
+				if i >= len(entries) {
+					return
+				}
+				m, err := f.openFileSetEntry(entries[i])
+				if err != nil {
+					err = fmt.Errorf("failed to parse fileset entry %s: %v", entries[i].EntryID, err)
+				} else {
+					err = fn(entries[i].FilesetEntry, m)
+				}
+				if err != nil {
+					errs[i] = err
+					atomic.StoreInt32(&failed, 1)
+				}
+			}
+		}()
+	}
+	wg.Wait()
+
+	for _, err := range errs {
+		if err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// GetFileSetFileByName returns the Fileset MachO for a given name: the entry with that exact id,
+// or else the first whose id contains name (ignoring case).
+func (f *File) GetFileSetFileByName(name string) (*File, error) {
+	idx := f.fileSetIndex()
+	if e, ok := idx.byName[name]; ok {
+		return f.openFileSetEntry(e)
+	}
+	lname := strings.ToLower(name)
+	for _, e := range idx.entries {
+		if strings.Contains(strings.ToLower(e.EntryID), lname) {
+			return f.openFileSetEntry(e)
+		}
+	}
+	return nil, fmt.Errorf("fileset does NOT contain %s", name)
+}
@@ -0,0 +1,182 @@
+package macho
+
+import (
+	"fmt"
+	"sort"
+
+	"github.com/blacktop/go-macho/pkg/trie"
+	"github.com/blacktop/go-macho/types"
+)
+
+// functionStartsLocked decodes (once) the LC_FUNCTION_STARTS data, or data if given, into the sorted
+// function boundaries: function i spans [starts[i], starts[i+1]). The caller must hold f.lazy.
+func (f *File) functionStartsLocked(data []byte) []uint64 {
+	if f.funcStarts != nil {
+		return f.funcStarts
+	}
+
+	fs := f.FunctionStarts()
+	if fs == nil {
+		return nil
+	}
+
+	if len(data) == 0 {
+		ldat, err := f.readData(int64(fs.Offset), uint64(fs.Size))
+		if err != nil {
+			return nil
+		}
+		data = ldat
+	}
+
+	// a truncated trailing delta is ignored like the zero padding that ends the list
+	offsets, _ := trie.DecodeUleb128s(data)
+	if len(offsets) == 0 {
+		return nil
+	}
+
+	starts := make([]uint64, 0, len(offsets)+1)
+	startVMA := offsets[0] + f.GetBaseAddress()
+	starts = append(starts, startVMA)
+	for _, offset := range offsets[1:] {
+		if offset == 0 {
+			break
+		}
+		startVMA += offset
+		starts = append(starts, startVMA)
+	}
+
+	// the last function ends with its section
+	if s := f.FindSectionForVMAddr(startVMA); s != nil {
+		starts = append(starts, s.Addr+s.Size)
+	}
+
+	f.funcStarts = starts
+	return starts
+}
+
+// functionStarts returns the sorted function boundaries (see functionStartsLocked)
+func (f *File) functionStarts() []uint64 {
+	f.lazy.Lock()
+	defer f.lazy.Unlock()
+	return f.functionStartsLocked(nil)
+}
+
+// searchFunctionStarts returns the index of the function containing addr or -1
+func searchFunctionStarts(starts []uint64, addr uint64) int {
+	i := sort.Search(len(starts), func(i int) bool { return starts[i] > addr }) - 1
+	if i < 0 || i >= len(starts)-1 {
+		return -1
+	}
+	return i
+}
+
+// FindFunctionsForVMAddrs maps each of the sorted addrs to the index of the function containing it
+// in GetFunctions(), or -1, in a single merge pass over the function starts.
+func (f *File) FindFunctionsForVMAddrs(addrs []uint64) ([]int, error) {
+	starts := f.functionStarts()
+	idxs := make([]int, len(addrs))
+	i := 0
+	for j, addr := range addrs {
+		if j > 0 && addr < addrs[j-1] {
+			return nil, fmt.Errorf("addrs must be sorted: %#x follows %#x", addr, addrs[j-1])
+		}
+		for i < len(starts) && starts[i] <= addr {
+			i++
+		}
+		// starts[i-1] <= addr < starts[i]
+		if i == 0 || i == len(starts) {
+			idxs[j] = -1
+		} else {
+			idxs[j] = i - 1
+		}
+	}
+	return idxs, nil
+}
+
+// FunctionTable is the LC_FUNCTION_STARTS function list joined with symbol names, built by File.GetFunctionTable
+type FunctionTable struct {
+	starts []uint64 // function i spans [starts[i], starts[i+1])
+	names  []string // names[i] is the name of function i or "" if no symbol starts there
+}
+
+// Len returns the number of functions in the table
+func (t *FunctionTable) Len() int {
+	return len(t.names)
+}
+
+// Function returns the i-th function in address order
+func (t *FunctionTable) Function(i int) types.Function {
+	return types.Function{Name: t.names[i], StartAddr: t.starts[i], EndAddr: t.starts[i+1]}
+}
+
+// Lookup returns the function containing addr
+func (t *FunctionTable) Lookup(addr uint64) (types.Function, bool) {
+	if i := searchFunctionStarts(t.starts, addr); i >= 0 {
+		return t.Function(i), true
+	}
+	return types.Function{}, false
+}
+
+// namedAddr is a candidate function name
+type namedAddr struct {
+	addr uint64
+	name string
+}
+
+// GetFunctionTable joins the function starts with the names of the symtab symbols and dyld exports that
+// start them. Both name sources are sorted by address and merged with the function starts in one pass;
+// a symtab name is preferred over an export name at the same address.
+func (f *File) GetFunctionTable() (*FunctionTable, error) {
+	f.lazy.Lock()
+	starts := f.functionStartsLocked(nil)
+	f.lazy.Unlock()
+	if len(starts) < 2 {
+		return nil, fmt.Errorf("macho does not contain LC_FUNCTION_STARTS")
+	}
+
+	var syms, exports []namedAddr
+	if f.Symtab != nil {
+		if err := f.ParseSymtab(); err != nil {
+			return nil, err
+		}
+		for _, sym := range f.Symtab.Syms {
+			if !sym.Type.IsDebugSym() && sym.Type.IsDefinedInSection() {
+				syms = append(syms, namedAddr{sym.Value, sym.Name})
+			}
+		}
+	}
+	if f.DyldExportsTrie() != nil {
+		if err := f.ForEachExport(func(e trie.TrieEntry) error {
+			if !e.Flags.ReExport() && !e.Flags.Absolute() {
+				exports = append(exports, namedAddr{e.Address, e.Name})
+			}
+			return nil
+		}); err != nil {
+			return nil, err
+		}
+	}
+	// stable so the first symbol in symtab order wins a tie
+	sort.SliceStable(syms, func(i, j int) bool { return syms[i].addr < syms[j].addr })
+	sort.SliceStable(exports, func(i, j int) bool { return exports[i].addr < exports[j].addr })
+
+	t := &FunctionTable{
+		starts: starts,
+		names:  make([]string, len(starts)-1),
+	}
+	var si, ei int
+	for i, start := range starts[:len(starts)-1] {
+		for si < len(syms) && syms[si].addr < start {
+			si++
+		}
+		for ei < len(exports) && exports[ei].addr < start {
+			ei++
+		}
+		if si < len(syms) && syms[si].addr == start {
+			t.names[i] = syms[si].name
+		} else if ei < len(exports) && exports[ei].addr == start {
+			t.names[i] = exports[ei].name
+		}
+	}
+
+	return t, nil
+}
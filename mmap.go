@@ -0,0 +1,52 @@
+package macho
+
+import (
+	"fmt"
+	"io"
+)
+
+// mmapReader is a read-only memory mapping of a Mach-O file on disk.
+// It satisfies io.ReaderAt and can also hand out sub-slices of the mapping
+// so that accessors like Section.Data avoid copying.
+type mmapReader struct {
+	data []byte
+}
+
+func newMmapReader(data []byte) *mmapReader {
+	return &mmapReader{data: data}
+}
+
+// ReadAt implements the io.ReaderAt interface
+func (m *mmapReader) ReadAt(p []byte, off int64) (int, error) {
+	if off < 0 {
+		return 0, fmt.Errorf("negative offset %#x", off)
+	}
+	if off >= int64(len(m.data)) {
+		return 0, io.EOF
+	}
+	n := copy(p, m.data[off:])
+	if n < len(p) {
+		return n, io.EOF
+	}
+	return n, nil
+}
+
+// Slice returns a view of size bytes at offset off into the mapping.
+// The returned slice MUST NOT be written to and is only valid until the
+// mapping is closed.
+func (m *mmapReader) Slice(off int64, size uint64) ([]byte, error) {
+	if off < 0 || uint64(off) > uint64(len(m.data)) || size > uint64(len(m.data))-uint64(off) {
+		return nil, fmt.Errorf("range %#x-%#x is outside of the mapped file (size %#x)", off, uint64(off)+size, len(m.data))
+	}
+	return m.data[off : uint64(off)+size : uint64(off)+size], nil
+}
+
+// Close unmaps the file
+func (m *mmapReader) Close() error {
+	if m.data == nil {
+		return nil
+	}
+	err := munmap(m.data)
+	m.data = nil
+	return err
+}
@@ -0,0 +1,19 @@
+//go:build !darwin && !dragonfly && !freebsd && !linux && !netbsd && !openbsd
+// +build !darwin,!dragonfly,!freebsd,!linux,!netbsd,!openbsd
+
+package macho
+
+import (
+	"io/ioutil"
+	"os"
+)
+
+// mmap falls back to reading the whole file into memory on platforms
+// without syscall.Mmap
+func mmap(f *os.File) ([]byte, error) {
+	return ioutil.ReadAll(f)
+}
+
+func munmap(b []byte) error {
+	return nil
+}
@@ -5,7 +5,10 @@ import (
 	"encoding/binary"
 	"fmt"
 	"io"
+	"runtime"
 	"strings"
+	"sync"
+	"sync/atomic"
 
 	"github.com/blacktop/go-macho/types"
 	"github.com/blacktop/go-macho/types/objc"
@@ -115,8 +118,7 @@ func (f *File) GetObjCClassInfo(vmAddr uint64) (*objc.ClassRO64, error) {
 		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 	}
 
-	f.sr.Seek(int64(off), io.SeekStart)
-	if err := binary.Read(f.sr, f.ByteOrder, &classData); err != nil {
+	if err := binary.Read(f.newReader(int64(off)), f.ByteOrder, &classData); err != nil {
 		return nil, fmt.Errorf("failed to read class_ro_t: %v", err)
 	}
 
@@ -160,97 +162,218 @@ func (f *File) GetObjCMethodNames() (map[string]uint64, error) {
 	return nil, fmt.Errorf("macho does not contain a __TEXT.__objc_methname section")
 }
 
-func (f *File) GetObjCClasses() ([]objc.Class, error) {
-	var classes []objc.Class
-
+// objcPointerList reads the pointers of the first __DATA*.<name> section, or returns a nil section if there is none
+func (f *File) objcPointerList(name string) ([]uint64, *Section, error) {
 	for _, s := range f.Segments() {
 		if strings.HasPrefix(s.Name, "__DATA") {
-			if sec := f.Section(s.Name, "__objc_classlist"); sec != nil {
+			if sec := f.Section(s.Name, name); sec != nil {
 				if sec.Size == 0 {
-					return nil, fmt.Errorf("%s.%s section has size 0", sec.Seg, sec.Name)
+					return nil, sec, fmt.Errorf("%s.%s section has size 0", sec.Seg, sec.Name)
 				}
 
 				dat, err := sec.Data()
 				if err != nil {
-					return nil, fmt.Errorf("failed to read __objc_classlist: %v", err)
-				}
-
-				ptrs := make([]uint64, sec.Size/8)
-				if err := binary.Read(bytes.NewReader(dat), f.ByteOrder, &ptrs); err != nil {
-					return nil, fmt.Errorf("failed to read objc_class_t pointers: %v", err)
+					return nil, sec, fmt.Errorf("failed to read %s: %v", name, err)
 				}
 
-				for _, ptr := range ptrs {
-					class, err := f.GetObjCClass(f.vma.Convert(ptr))
-					if err != nil {
-						return nil, fmt.Errorf("failed to read objc_class_t at vmaddr: 0x%x; %v", ptr, err)
-					}
-					classes = append(classes, *class)
+				ptrs := make([]uint64, len(dat)/8)
+				for i := range ptrs {
+					ptrs[i] = f.ByteOrder.Uint64(dat[i*8:])
 				}
-				return classes, nil
+				return ptrs, sec, nil
 			}
 		}
 	}
-	return nil, fmt.Errorf("macho does not contain a __objc_classlist section")
+	return nil, nil, nil
 }
 
-func (f *File) GetObjCPlusLoadClasses() ([]objc.Class, error) {
-	var classes []objc.Class
-
-	for _, s := range f.Segments() {
-		if strings.HasPrefix(s.Name, "__DATA") {
-			if sec := f.Section(s.Name, "__objc_nlclslist"); sec != nil {
-				if sec.Size == 0 {
-					return nil, fmt.Errorf("%s.%s section has size 0", sec.Seg, sec.Name)
-				}
+// forEachObjCPointer calls fn for each of ptrs on up to workers goroutines (runtime.NumCPU() if workers <= 0).
+// Once fn fails no new pointers are handed out; the error of the first failing pointer in list order is returned.
+func forEachObjCPointer(ptrs []uint64, workers int, fn func(i int, ptr uint64) error) error {
+	if workers <= 0 {
+		workers = runtime.NumCPU()
+	}
+	if workers > len(ptrs) {
+		workers = len(ptrs)
+	}
 
-				dat, err := sec.Data()
-				if err != nil {
-					return nil, fmt.Errorf("failed to read __objc_nlclslist: %v", err)
-				}
+	if workers <= 1 {
+		for i, ptr := range ptrs {
+			if err := fn(i, ptr); err != nil {
+				return err
+			}
+		}
+		return nil
+	}
 
-				ptrs := make([]uint64, sec.Size/8)
-				if err := binary.Read(bytes.NewReader(dat), f.ByteOrder, &ptrs); err != nil {
-					return nil, fmt.Errorf("failed to read objc_class_t pointers: %v", err)
+	var next int64 = -1
+	var failed int32
+	errs := make([]error, len(ptrs))
+	var wg sync.WaitGroup
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for atomic.LoadInt32(&failed) == 0 {
+				i := int(atomic.AddInt64(&next, 1))
+				if i >= len(ptrs) {
+					return
 				}
-
-				for _, ptr := range ptrs {
-					class, err := f.GetObjCClass(f.vma.Convert(ptr))
-					if err != nil {
-						return nil, fmt.Errorf("failed to read objc_class_t at vmaddr: 0x%x; %v", ptr, err)
-					}
-					classes = append(classes, *class)
+				if err := fn(i, ptrs[i]); err != nil {
+					errs[i] = err
+					atomic.StoreInt32(&failed, 1)
 				}
-				return classes, nil
 			}
+		}()
+	}
+	wg.Wait()
+
+	for _, err := range errs {
+		if err != nil {
+			return err
 		}
 	}
-	return nil, fmt.Errorf("macho does not contain a __objc_nlclslist section")
+	return nil
 }
 
-// GetObjCClass parses an ObjC class at a given virtual memory address
-func (f *File) GetObjCClass(vmaddr uint64) (*objc.Class, error) {
+// getObjCClassList parses the classes of the __objc_classlist-like section name
+func (f *File) getObjCClassList(name string, workers int) ([]objc.Class, error) {
+	ptrs, sec, err := f.objcPointerList(name)
+	if err != nil {
+		return nil, err
+	}
+	if sec == nil {
+		return nil, fmt.Errorf("macho does not contain a %s section", name)
+	}
+
+	classes := make([]objc.Class, len(ptrs))
+	if err := forEachObjCPointer(ptrs, workers, func(i int, ptr uint64) error {
+		class, err := f.GetObjCClass(f.vma.Convert(ptr))
+		if err != nil {
+			return fmt.Errorf("failed to read objc_class_t at vmaddr: 0x%x; %v", ptr, err)
+		}
+		classes[i] = *class
+		return nil
+	}); err != nil {
+		return nil, err
+	}
+	return classes, nil
+}
+
+// GetObjCClasses parses the classes in __objc_classlist
+func (f *File) GetObjCClasses() ([]objc.Class, error) {
+	return f.GetObjCClassesParallel(1)
+}
+
+// GetObjCClassesParallel is GetObjCClasses parsing the classes on up to workers goroutines
+// (runtime.NumCPU() if workers <= 0). The classes are returned in list order.
+func (f *File) GetObjCClassesParallel(workers int) ([]objc.Class, error) {
+	return f.getObjCClassList("__objc_classlist", workers)
+}
+
+// GetObjCPlusLoadClasses parses the classes with a +load method in __objc_nlclslist
+func (f *File) GetObjCPlusLoadClasses() ([]objc.Class, error) {
+	return f.GetObjCPlusLoadClassesParallel(1)
+}
+
+// GetObjCPlusLoadClassesParallel is GetObjCPlusLoadClasses parsing the classes on up to workers
+// goroutines (runtime.NumCPU() if workers <= 0). The classes are returned in list order.
+func (f *File) GetObjCPlusLoadClassesParallel(workers int) ([]objc.Class, error) {
+	return f.getObjCClassList("__objc_nlclslist", workers)
+}
+
+// objcCache memoizes the classes parsed by GetObjCClass and the class references they point to
+type objcCache struct {
+	sync.Mutex
+	classes map[uint64]*objc.Class  // class vmaddr -> fully parsed class
+	refs    map[uint64]objcClassRef // class vmaddr -> name and class_ro_t
+
+	indexOnce sync.Once
+	index     *ObjCRefIndex
+	indexErr  error
+}
+
+// objcClassRef is what a class needs from its superclass (the name) and metaclass (the name and class methods)
+type objcClassRef struct {
+	name string
+	info objc.ClassRO64
+}
+
+// readObjCClassHeader reads the objc_class_t at vmaddr and its class_ro_t
+func (f *File) readObjCClassHeader(vmaddr uint64) (objc.SwiftClassMetadata64, *objc.ClassRO64, uint64, error) {
 	var classPtr objc.SwiftClassMetadata64
 
 	off, err := f.vma.GetOffset(vmaddr)
 	if err != nil {
-		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
+		return classPtr, nil, 0, fmt.Errorf("failed to convert vmaddr: %v", err)
 	}
 
-	f.sr.Seek(int64(off), io.SeekStart)
-	if err := binary.Read(f.sr, f.ByteOrder, &classPtr); err != nil {
-		return nil, fmt.Errorf("failed to read swift_class_metadata_t: %v", err)
+	if err := binary.Read(f.newReader(int64(off)), f.ByteOrder, &classPtr); err != nil {
+		return classPtr, nil, 0, fmt.Errorf("failed to read swift_class_metadata_t: %v", err)
 	}
 
 	info, err := f.GetObjCClassInfo(f.vma.Convert(classPtr.DataVMAddrAndFastFlags) & objc.FAST_DATA_MASK64)
 	if err != nil {
-		return nil, fmt.Errorf("failed to get class info at vmaddr: 0x%x; %v", classPtr.DataVMAddrAndFastFlags&objc.FAST_DATA_MASK64, err)
+		return classPtr, nil, 0, fmt.Errorf("failed to get class info at vmaddr: 0x%x; %v", classPtr.DataVMAddrAndFastFlags&objc.FAST_DATA_MASK64, err)
+	}
+
+	return classPtr, info, off, nil
+}
+
+// getObjCClassRef returns the name and class_ro_t of the class at vmaddr without parsing the rest of it
+func (f *File) getObjCClassRef(vmaddr uint64) (objcClassRef, error) {
+	f.objcCache.Lock()
+	ref, ok := f.objcCache.refs[vmaddr]
+	f.objcCache.Unlock()
+	if ok {
+		return ref, nil
+	}
+
+	_, info, _, err := f.readObjCClassHeader(vmaddr)
+	if err != nil {
+		return objcClassRef{}, err
+	}
+	ref.info = *info
+	ref.name, err = f.GetCString(f.vma.Convert(info.NameVMAddr))
+	if err != nil {
+		return objcClassRef{}, fmt.Errorf("failed to read cstring: %v", err)
+	}
+
+	f.cacheObjCClassRef(vmaddr, ref)
+	return ref, nil
+}
+
+func (f *File) cacheObjCClassRef(vmaddr uint64, ref objcClassRef) {
+	f.objcCache.Lock()
+	if f.objcCache.refs == nil {
+		f.objcCache.refs = make(map[uint64]objcClassRef)
+	}
+	f.objcCache.refs[vmaddr] = ref
+	f.objcCache.Unlock()
+}
+
+// GetObjCClass parses an ObjC class at a given virtual memory address.
+// Classes are parsed once per File; the superclass and isa (metaclass) are only resolved
+// to their name and vmaddr (SuperClass/SuperclassVMAddr and Isa/IsaVMAddr).
+// Each call returns a separate copy of the class, including its method, ivar, property and protocol lists.
+func (f *File) GetObjCClass(vmaddr uint64) (*objc.Class, error) {
+	f.objcCache.Lock()
+	cached, ok := f.objcCache.classes[vmaddr]
+	f.objcCache.Unlock()
+	if ok {
+		return cloneObjCClass(cached), nil
+	}
+
+	classPtr, info, off, err := f.readObjCClassHeader(vmaddr)
+	if err != nil {
+		return nil, err
 	}
 
 	name, err := f.GetCString(f.vma.Convert(info.NameVMAddr))
 	if err != nil {
 		return nil, fmt.Errorf("failed to read cstring: %v", err)
 	}
+	f.cacheObjCClassRef(vmaddr, objcClassRef{name: name, info: *info})
 
 	var methods []objc.Method
 	if info.BaseMethodsVMAddr > 0 {
@@ -284,47 +407,54 @@ func (f *File) GetObjCClass(vmaddr uint64) (*objc.Class, error) {
 		}
 	}
 
-	superClass := &objc.Class{Name: "<ROOT>"}
+	superClass := "<ROOT>"
 	if classPtr.SuperclassVMAddr > 0 {
 		if !info.Flags.IsRoot() {
-			superClass, err = f.GetObjCClass(f.vma.Convert(classPtr.SuperclassVMAddr))
-			if err != nil {
-				if f.HasFixups() {
-					bindName, err := f.GetBindName(classPtr.SuperclassVMAddr)
-					if err == nil {
-						superClass = &objc.Class{Name: strings.TrimPrefix(bindName, "_OBJC_CLASS_$_")}
-					} else {
-						return nil, fmt.Errorf("failed to read super class objc_class_t at vmaddr: 0x%x; %v", vmaddr, err)
-					}
+			ref, err := f.getObjCClassRef(f.vma.Convert(classPtr.SuperclassVMAddr))
+			if err == nil {
+				superClass = ref.name
+			} else if f.HasFixups() {
+				bindName, err := f.GetBindName(classPtr.SuperclassVMAddr)
+				if err == nil {
+					superClass = strings.TrimPrefix(bindName, "_OBJC_CLASS_$_")
+				} else {
+					return nil, fmt.Errorf("failed to read super class objc_class_t at vmaddr: 0x%x; %v", vmaddr, err)
 				}
+			} else {
+				superClass = ""
 			}
 		}
 	}
 
-	isaClass := &objc.Class{}
+	var isaClass string
 	var cMethods []objc.Method
 	if classPtr.IsaVMAddr > 0 {
 		if !info.Flags.IsMeta() {
-			isaClass, err = f.GetObjCClass(f.vma.Convert(classPtr.IsaVMAddr))
+			ref, err := f.getObjCClassRef(f.vma.Convert(classPtr.IsaVMAddr))
 			if err != nil {
 				bindName, err := f.GetBindName(classPtr.IsaVMAddr)
 				if err == nil {
-					isaClass = &objc.Class{Name: strings.TrimPrefix(bindName, "_OBJC_CLASS_$_")}
+					isaClass = strings.TrimPrefix(bindName, "_OBJC_CLASS_$_")
 				} else {
 					return nil, fmt.Errorf("failed to read super class objc_class_t at vmaddr: 0x%x; %v", vmaddr, err)
 				}
 			} else {
-				if isaClass.ReadOnlyData.Flags.IsMeta() {
-					cMethods = isaClass.InstanceMethods
+				isaClass = ref.name
+				// the metaclass's instance methods are the class methods
+				if ref.info.Flags.IsMeta() && ref.info.BaseMethodsVMAddr > 0 {
+					cMethods, err = f.GetObjCMethods(f.vma.Convert(ref.info.BaseMethodsVMAddr))
+					if err != nil {
+						return nil, fmt.Errorf("failed to get class methods at vmaddr: 0x%x; %v", ref.info.BaseMethodsVMAddr, err)
+					}
 				}
 			}
 		}
 	}
 
-	return &objc.Class{
+	class := &objc.Class{
 		Name:            name,
-		SuperClass:      superClass.Name,
-		Isa:             isaClass.Name,
+		SuperClass:      superClass,
+		Isa:             isaClass,
 		InstanceMethods: methods,
 		ClassMethods:    cMethods,
 		Ivars:           ivars,
@@ -342,70 +472,110 @@ func (f *File) GetObjCClass(vmaddr uint64) (*objc.Class, error) {
 		IsSwiftLegacy:         (classPtr.DataVMAddrAndFastFlags&objc.FAST_IS_SWIFT_LEGACY == 1),
 		IsSwiftStable:         (classPtr.DataVMAddrAndFastFlags&objc.FAST_IS_SWIFT_STABLE == 1),
 		ReadOnlyData:          *info,
-	}, nil
+	}
+
+	f.objcCache.Lock()
+	if f.objcCache.classes == nil {
+		f.objcCache.classes = make(map[uint64]*objc.Class)
+	}
+	f.objcCache.classes[vmaddr] = class
+	f.objcCache.Unlock()
+
+	return cloneObjCClass(class), nil
 }
 
-func (f *File) GetObjCCategories() ([]objc.Category, error) {
-	var categoryPtr objc.CategoryT
-	var categories []objc.Category
+// cloneObjCClass returns a copy of c that shares no slices with it, so callers can't modify the cache
+func cloneObjCClass(c *objc.Class) *objc.Class {
+	clone := *c
+	clone.InstanceMethods = append([]objc.Method(nil), c.InstanceMethods...)
+	clone.ClassMethods = append([]objc.Method(nil), c.ClassMethods...)
+	clone.Ivars = append([]objc.Ivar(nil), c.Ivars...)
+	clone.Props = append([]objc.Property(nil), c.Props...)
+	clone.Prots = cloneObjCProtocols(c.Prots)
+	return &clone
+}
 
-	for _, s := range f.Segments() {
-		if strings.HasPrefix(s.Name, "__DATA") {
-			if sec := f.Section(s.Name, "__objc_catlist"); sec != nil {
-				if sec.Size == 0 {
-					return nil, fmt.Errorf("%s.%s section has size 0", sec.Seg, sec.Name)
-				}
+func cloneObjCProtocols(prots []objc.Protocol) []objc.Protocol {
+	if prots == nil {
+		return nil
+	}
+	clones := make([]objc.Protocol, len(prots))
+	for i, p := range prots {
+		p.Prots = cloneObjCProtocols(p.Prots)
+		p.InstanceMethods = append([]objc.Method(nil), p.InstanceMethods...)
+		p.InstanceProperties = append([]objc.Property(nil), p.InstanceProperties...)
+		p.ClassMethods = append([]objc.Method(nil), p.ClassMethods...)
+		p.OptionalInstanceMethods = append([]objc.Method(nil), p.OptionalInstanceMethods...)
+		p.OptionalClassMethods = append([]objc.Method(nil), p.OptionalClassMethods...)
+		clones[i] = p
+	}
+	return clones
+}
 
-				dat, err := sec.Data()
-				if err != nil {
-					return nil, fmt.Errorf("failed to read __objc_catlist: %v", err)
-				}
-				ptrs := make([]uint64, sec.Size/8)
-				if err := binary.Read(bytes.NewReader(dat), f.ByteOrder, &ptrs); err != nil {
-					return nil, fmt.Errorf("failed to read objc_category_t pointers: %v", err)
-				}
+// GetObjCCategories parses the categories in __objc_catlist
+func (f *File) GetObjCCategories() ([]objc.Category, error) {
+	return f.GetObjCCategoriesParallel(1)
+}
 
-				for _, ptr := range ptrs {
-					off, err := f.vma.GetOffset(f.vma.Convert(ptr))
-					if err != nil {
-						return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
-					}
+// GetObjCCategoriesParallel is GetObjCCategories parsing the categories on up to workers goroutines
+// (runtime.NumCPU() if workers <= 0). The categories are returned in list order.
+func (f *File) GetObjCCategoriesParallel(workers int) ([]objc.Category, error) {
+	ptrs, sec, err := f.objcPointerList("__objc_catlist")
+	if err != nil {
+		return nil, err
+	}
+	if sec == nil {
+		return nil, fmt.Errorf("macho does not contain a __objc_catlist section")
+	}
 
-					f.sr.Seek(int64(off), io.SeekStart)
-					if err := binary.Read(f.sr, f.ByteOrder, &categoryPtr); err != nil {
-						return nil, fmt.Errorf("failed to read objc_category_t: %v", err)
-					}
+	categories := make([]objc.Category, len(ptrs))
+	if err := forEachObjCPointer(ptrs, workers, func(i int, ptr uint64) error {
+		category, err := f.getObjCCategory(ptr)
+		if err != nil {
+			return err
+		}
+		categories[i] = *category
+		return nil
+	}); err != nil {
+		return nil, err
+	}
+	return categories, nil
+}
 
-					category := objc.Category{VMAddr: ptr, CategoryT: categoryPtr}
+func (f *File) getObjCCategory(ptr uint64) (*objc.Category, error) {
+	var categoryPtr objc.CategoryT
 
-					category.Name, err = f.GetCString(f.vma.Convert(categoryPtr.NameVMAddr))
-					if err != nil {
-						return nil, fmt.Errorf("failed to read cstring: %v", err)
-					}
+	off, err := f.vma.GetOffset(f.vma.Convert(ptr))
+	if err != nil {
+		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
+	}
 
-					if categoryPtr.ClassMethodsVMAddr > 0 {
-						category.ClassMethods, err = f.GetObjCMethods(f.vma.Convert(categoryPtr.ClassMethodsVMAddr))
-						if err != nil {
-							return nil, fmt.Errorf("failed to get class methods at vmaddr: 0x%x; %v", categoryPtr.ClassMethodsVMAddr, err)
-						}
-					}
+	if err := binary.Read(f.newReader(int64(off)), f.ByteOrder, &categoryPtr); err != nil {
+		return nil, fmt.Errorf("failed to read objc_category_t: %v", err)
+	}
 
-					if categoryPtr.InstanceMethodsVMAddr > 0 {
-						category.InstanceMethods, err = f.GetObjCMethods(f.vma.Convert(categoryPtr.InstanceMethodsVMAddr))
-						if err != nil {
-							return nil, fmt.Errorf("failed to get instance methods at vmaddr: 0x%x; %v", categoryPtr.InstanceMethodsVMAddr, err)
-						}
-					}
+	category := objc.Category{VMAddr: ptr, CategoryT: categoryPtr}
 
-					categories = append(categories, category)
-				}
+	category.Name, err = f.GetCString(f.vma.Convert(categoryPtr.NameVMAddr))
+	if err != nil {
+		return nil, fmt.Errorf("failed to read cstring: %v", err)
+	}
 
-				return categories, nil
-			}
+	if categoryPtr.ClassMethodsVMAddr > 0 {
+		category.ClassMethods, err = f.GetObjCMethods(f.vma.Convert(categoryPtr.ClassMethodsVMAddr))
+		if err != nil {
+			return nil, fmt.Errorf("failed to get class methods at vmaddr: 0x%x; %v", categoryPtr.ClassMethodsVMAddr, err)
+		}
+	}
+
+	if categoryPtr.InstanceMethodsVMAddr > 0 {
+		category.InstanceMethods, err = f.GetObjCMethods(f.vma.Convert(categoryPtr.InstanceMethodsVMAddr))
+		if err != nil {
+			return nil, fmt.Errorf("failed to get instance methods at vmaddr: 0x%x; %v", categoryPtr.InstanceMethodsVMAddr, err)
 		}
 	}
 
-	return nil, fmt.Errorf("macho does not contain a __objc_catlist section")
+	return &category, nil
 }
 
 // GetCFStrings parses all the cfstrings in tne MachO
@@ -465,15 +635,15 @@ func (f *File) parseObjcProtocolList(vmaddr uint64) ([]objc.Protocol, error) {
 		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 	}
 
-	f.sr.Seek(int64(off), io.SeekStart)
+	r := f.newReader(int64(off))
 
 	var protList objc.ProtocolList
-	if err := binary.Read(f.sr, f.ByteOrder, &protList.Count); err != nil {
+	if err := binary.Read(r, f.ByteOrder, &protList.Count); err != nil {
 		return nil, fmt.Errorf("failed to read protocol_list_t count: %v", err)
 	}
 
 	protList.Protocols = make([]uint64, protList.Count)
-	if err := binary.Read(f.sr, f.ByteOrder, &protList.Protocols); err != nil {
+	if err := binary.Read(r, f.ByteOrder, &protList.Protocols); err != nil {
 		return nil, fmt.Errorf("failed to read protocol_list_t prots: %v", err)
 	}
 
@@ -496,9 +666,7 @@ func (f *File) getObjcProtocol(vmaddr uint64) (*objc.Protocol, error) {
 		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 	}
 
-	f.sr.Seek(int64(off), io.SeekStart)
-
-	if err := binary.Read(f.sr, f.ByteOrder, &protoPtr); err != nil {
+	if err := binary.Read(f.newReader(int64(off)), f.ByteOrder, &protoPtr); err != nil {
 		return nil, fmt.Errorf("failed to read protocol_t: %v", err)
 	}
 
@@ -569,9 +737,8 @@ func (f *File) getObjcProtocol(vmaddr uint64) (*objc.Protocol, error) {
 			return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 		}
 
-		f.sr.Seek(int64(extOff), io.SeekStart)
 		var extMPtr uint64
-		if err := binary.Read(f.sr, f.ByteOrder, &extMPtr); err != nil {
+		if err := binary.Read(f.newReader(int64(extOff)), f.ByteOrder, &extMPtr); err != nil {
 			return nil, fmt.Errorf("failed to read ExtendedMethodTypesVMAddr: %v", err)
 		}
 
@@ -601,39 +768,34 @@ func (f *File) getObjcProtocol(vmaddr uint64) (*objc.Protocol, error) {
 	return &proto, nil
 }
 
+// GetObjCProtocols parses the protocols in __objc_protolist
 func (f *File) GetObjCProtocols() ([]objc.Protocol, error) {
+	return f.GetObjCProtocolsParallel(1)
+}
 
-	var protocols []objc.Protocol
-
-	for _, s := range f.Segments() {
-		if strings.HasPrefix(s.Name, "__DATA") {
-			if sec := f.Section(s.Name, "__objc_protolist"); sec != nil {
-				if sec.Size == 0 {
-					return nil, fmt.Errorf("%s.%s section has size 0", sec.Seg, sec.Name)
-				}
-
-				dat, err := sec.Data()
-				if err != nil {
-					return nil, fmt.Errorf("failed to read __objc_protolist: %v", err)
-				}
-
-				ptrs := make([]uint64, sec.Size/8)
-				if err := binary.Read(bytes.NewReader(dat), f.ByteOrder, &ptrs); err != nil {
-					return nil, fmt.Errorf("failed to read protocol_t pointers: %v", err)
-				}
+// GetObjCProtocolsParallel is GetObjCProtocols parsing the protocols on up to workers goroutines
+// (runtime.NumCPU() if workers <= 0). The protocols are returned in list order.
+func (f *File) GetObjCProtocolsParallel(workers int) ([]objc.Protocol, error) {
+	ptrs, sec, err := f.objcPointerList("__objc_protolist")
+	if err != nil {
+		return nil, err
+	}
+	if sec == nil {
+		return nil, fmt.Errorf("macho does not contain a __objc_protolist section")
+	}
 
-				for _, ptr := range ptrs {
-					proto, err := f.getObjcProtocol(f.vma.Convert(ptr))
-					if err != nil {
-						return nil, fmt.Errorf("failed to read protocol at pointer %#x: %v", ptr, err)
-					}
-					protocols = append(protocols, *proto)
-				}
-				return protocols, nil
-			}
+	protocols := make([]objc.Protocol, len(ptrs))
+	if err := forEachObjCPointer(ptrs, workers, func(i int, ptr uint64) error {
+		proto, err := f.getObjcProtocol(f.vma.Convert(ptr))
+		if err != nil {
+			return fmt.Errorf("failed to read protocol at pointer %#x: %v", ptr, err)
 		}
+		protocols[i] = *proto
+		return nil
+	}); err != nil {
+		return nil, err
 	}
-	return nil, fmt.Errorf("macho does not contain a __objc_protolist section")
+	return protocols, nil
 }
 
 func (f *File) GetObjCMethodList() ([]objc.Method, error) {
@@ -662,17 +824,22 @@ func (f *File) GetObjCMethodList() ([]objc.Method, error) {
 				return nil, fmt.Errorf("failed to read method_list_t: %v", err)
 			}
 
-			methods := make([]objc.MethodSmallT, methodList.Count)
-			if err := binary.Read(mlr, f.ByteOrder, &methods); err != nil {
+			if uint64(methodList.Count)*objc.MethodSmallTSize > uint64(mlr.Size()-(currOffset-int64(sec.Offset))) {
+				return nil, fmt.Errorf("method_list_t at offset %#x overflows %s.%s", currOffset-8, sec.Seg, sec.Name)
+			}
+			mdat := make([]byte, int(methodList.Count)*objc.MethodSmallTSize)
+			if _, err := io.ReadFull(mlr, mdat); err != nil {
 				return nil, fmt.Errorf("failed to read method_t(s) (small): %v", err)
 			}
 
-			for _, method := range methods {
-				var nameAddr uint32
-				f.sr.Seek(int64(method.NameOffset)+currOffset, io.SeekStart)
-				if err := binary.Read(f.sr, f.ByteOrder, &nameAddr); err != nil {
+			var buf [4]byte
+			for i := uint32(0); i < methodList.Count; i++ {
+				var method objc.MethodSmallT
+				method.Get(mdat[int(i)*objc.MethodSmallTSize:], f.ByteOrder)
+				if _, err := f.sr.ReadAt(buf[:], int64(method.NameOffset)+currOffset); err != nil {
 					return nil, fmt.Errorf("failed to read nameAddr(small): %v", err)
 				}
+				nameAddr := f.ByteOrder.Uint32(buf[:])
 				n, err := f.GetCString(uint64(nameAddr))
 				if err != nil {
 					return nil, fmt.Errorf("failed to read cstring: %v", err)
@@ -717,6 +884,161 @@ func (f *File) GetObjCMethodList() ([]objc.Method, error) {
 	return nil, fmt.Errorf("macho does not contain a __objc_methlist section")
 }
 
+// methodTableBuilder decodes small method lists into a MethodTable
+type methodTableBuilder struct {
+	f     *File
+	table *objc.MethodTable
+	strs  map[uint64]uint32 // cstring vmaddr -> offset in table.Strings
+	secs  []*Section        // sections read so far (selrefs, method names and types)
+	dats  [][]byte
+}
+
+// local returns the contents of this image's section containing vmaddr from vmaddr on, reading each
+// section once; ok is false if none of the sections contains vmaddr (e.g. shared cache strings)
+func (b *methodTableBuilder) local(vmaddr uint64) (dat []byte, ok bool, err error) {
+	for i, sec := range b.secs {
+		if sec.Addr <= vmaddr && vmaddr < sec.Addr+uint64(len(b.dats[i])) {
+			return b.dats[i][vmaddr-sec.Addr:], true, nil
+		}
+	}
+	sec := b.f.FindSectionForVMAddr(vmaddr)
+	if sec == nil {
+		return nil, false, nil
+	}
+	dat, err = sec.Data()
+	if err != nil {
+		return nil, false, fmt.Errorf("failed to read %s.%s: %v", sec.Seg, sec.Name, err)
+	}
+	if vmaddr-sec.Addr >= uint64(len(dat)) {
+		return nil, false, nil
+	}
+	b.secs = append(b.secs, sec)
+	b.dats = append(b.dats, dat)
+	return dat[vmaddr-sec.Addr:], true, nil
+}
+
+// pointer reads the pointer at vmaddr
+func (b *methodTableBuilder) pointer(vmaddr uint64) (uint64, error) {
+	dat, ok, err := b.local(vmaddr)
+	if err != nil {
+		return 0, err
+	}
+	if ok && len(dat) >= 8 {
+		return b.f.ByteOrder.Uint64(dat), nil
+	}
+	off, err := b.f.vma.GetOffset(vmaddr)
+	if err != nil {
+		return 0, fmt.Errorf("failed to convert vmaddr: %v", err)
+	}
+	var buf [8]byte
+	if _, err := b.f.sr.ReadAt(buf[:], int64(off)); err != nil {
+		return 0, err
+	}
+	return b.f.ByteOrder.Uint64(buf[:]), nil
+}
+
+// intern returns the offset in the string table of the cstring at vmaddr, copying it there the first time
+func (b *methodTableBuilder) intern(vmaddr uint64) (uint32, error) {
+	if off, ok := b.strs[vmaddr]; ok {
+		return off, nil
+	}
+	dat, ok, err := b.local(vmaddr)
+	if err != nil {
+		return 0, err
+	}
+	off := uint32(len(b.table.Strings))
+	if end := bytes.IndexByte(dat, 0); ok && end >= 0 {
+		b.table.Strings = append(b.table.Strings, dat[:end+1]...)
+	} else {
+		// the string is outside this image's sections (or runs past one); read it like GetCString does
+		s, err := b.f.GetCString(vmaddr)
+		if err != nil {
+			return 0, fmt.Errorf("failed to read cstring: %v", err)
+		}
+		b.table.Strings = append(append(b.table.Strings, s...), 0)
+	}
+	b.strs[vmaddr] = off
+	return off, nil
+}
+
+// GetObjCMethodTable decodes every small method list in __TEXT.__objc_methlist into a columnar
+// MethodTable in one pass over the section. The selector references, names and types in this image
+// are read a section at a time (strings elsewhere in a shared cache are read through the reader) and
+// each distinct string is stored once.
+func (f *File) GetObjCMethodTable() (*objc.MethodTable, error) {
+	sec := f.Section("__TEXT", "__objc_methlist")
+	if sec == nil {
+		return nil, fmt.Errorf("macho does not contain a __objc_methlist section")
+	}
+	if sec.Size == 0 {
+		return nil, fmt.Errorf("%s.%s section has size 0", sec.Seg, sec.Name)
+	}
+	dat, err := sec.Data()
+	if err != nil {
+		return nil, fmt.Errorf("failed to read __objc_methlist: %v", err)
+	}
+
+	// every method takes at least objc.MethodSmallTSize bytes
+	maxMethods := len(dat) / objc.MethodSmallTSize
+	b := methodTableBuilder{
+		f: f,
+		table: &objc.MethodTable{
+			NameOffsets: make([]uint32, 0, maxMethods),
+			TypeOffsets: make([]uint32, 0, maxMethods),
+			Imps:        make([]uint64, 0, maxMethods),
+		},
+		strs: make(map[uint64]uint32),
+	}
+	inCache := f.Flags.DylibInCache()
+
+	var methodList objc.MethodList
+	for p := 0; p+8 <= len(dat); p = int(types.RoundUp(uint64(p), 8)) {
+		methodList.EntSizeAndFlags = f.ByteOrder.Uint32(dat[p:])
+		methodList.Count = f.ByteOrder.Uint32(dat[p+4:])
+		p += 8
+		if methodList.EntSizeAndFlags == 0 && methodList.Count == 0 {
+			continue // padding
+		}
+		if !methodList.IsSmall() || methodList.EntSize() < objc.MethodSmallTSize {
+			return nil, fmt.Errorf("unsupported method_list_t at vmaddr %#x: %s", sec.Addr+uint64(p-8), methodList)
+		}
+		entSize := int(methodList.EntSize())
+		if p+int(methodList.Count)*entSize > len(dat) {
+			return nil, fmt.Errorf("method_list_t at vmaddr %#x overflows __objc_methlist", sec.Addr+uint64(p-8))
+		}
+
+		b.table.Lists = append(b.table.Lists, uint32(len(b.table.Imps)))
+		for i := uint32(0); i < methodList.Count; i, p = i+1, p+entSize {
+			var method objc.MethodSmallT
+			method.Get(dat[p:], f.ByteOrder)
+			addr := sec.Addr + uint64(p) // the offsets are relative to the field holding them
+
+			nameVMAddr := uint64(int64(addr) + int64(method.NameOffset))
+			if !inCache { // the name offset points to a selector reference
+				ref, err := b.pointer(nameVMAddr)
+				if err != nil {
+					return nil, fmt.Errorf("failed to read selector reference at vmaddr %#x: %v", nameVMAddr, err)
+				}
+				nameVMAddr = f.vma.Convert(ref)
+			}
+			nameOff, err := b.intern(nameVMAddr)
+			if err != nil {
+				return nil, fmt.Errorf("failed to read method name: %v", err)
+			}
+			typesOff, err := b.intern(uint64(int64(addr+4) + int64(method.TypesOffset)))
+			if err != nil {
+				return nil, fmt.Errorf("failed to read method types: %v", err)
+			}
+
+			b.table.NameOffsets = append(b.table.NameOffsets, nameOff)
+			b.table.TypeOffsets = append(b.table.TypeOffsets, typesOff)
+			b.table.Imps = append(b.table.Imps, uint64(int64(addr+8)+int64(method.ImpOffset)))
+		}
+	}
+
+	return b.table, nil
+}
+
 func (f *File) GetObjCMethods(vmAddr uint64) ([]objc.Method, error) {
 
 	var methodList objc.MethodList
@@ -726,35 +1048,61 @@ func (f *File) GetObjCMethods(vmAddr uint64) ([]objc.Method, error) {
 		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 	}
 
-	f.sr.Seek(int64(off), io.SeekStart)
-	if err := binary.Read(f.sr, f.ByteOrder, &methodList); err != nil {
+	if err := binary.Read(f.newReader(int64(off)), f.ByteOrder, &methodList); err != nil {
 		return nil, fmt.Errorf("failed to read method_list_t: %v", err)
 	}
 
+	// the method_t entries directly follow the method_list_t header
+	off += uint64(binary.Size(methodList))
+
 	if methodList.IsSmall() {
-		return f.readSmallMethods(methodList)
+		return f.readSmallMethods(methodList, int64(off))
 	}
 
-	return f.readBigMethods(methodList)
+	return f.readBigMethods(methodList, int64(off))
+}
+
+// allocMethodEntries allocates the buffer for the method_t entries of methodList at file offset off,
+// failing if they would run past the end of the segment containing them (or of the file if none does)
+func (f *File) allocMethodEntries(methodList objc.MethodList, entSize int, off int64) ([]byte, error) {
+	if off < 0 {
+		return nil, fmt.Errorf("invalid method_list_t offset %#x", off-8)
+	}
+	end := uint64(f.sr.Size())
+	for _, seg := range f.Segments() {
+		if seg.Offset <= uint64(off) && uint64(off) < seg.Offset+seg.Filesz {
+			end = seg.Offset + seg.Filesz
+			break
+		}
+	}
+	size := uint64(methodList.Count) * uint64(entSize)
+	if uint64(off) > end || size > end-uint64(off) {
+		return nil, fmt.Errorf("method_list_t at offset %#x overflows its segment", off-8)
+	}
+	return make([]byte, size), nil
 }
 
-func (f *File) readSmallMethods(methodList objc.MethodList) ([]objc.Method, error) {
+func (f *File) readSmallMethods(methodList objc.MethodList, currOffset int64) ([]objc.Method, error) {
 	var err error
 	var nameVMAddr uint64
 	var objcMethods []objc.Method
 
-	currOffset, _ := f.sr.Seek(0, io.SeekCurrent)
-
-	methods := make([]objc.MethodSmallT, methodList.Count)
-	if err := binary.Read(f.sr, f.ByteOrder, &methods); err != nil {
+	mdat, err := f.allocMethodEntries(methodList, objc.MethodSmallTSize, currOffset)
+	if err != nil {
+		return nil, err
+	}
+	if _, err := f.sr.ReadAt(mdat, currOffset); err != nil {
 		return nil, fmt.Errorf("failed to read method_t(s) (small): %v", err)
 	}
 
-	for _, method := range methods {
-		f.sr.Seek(currOffset+int64(method.NameOffset), io.SeekStart)
-		if err := binary.Read(f.sr, f.ByteOrder, &nameVMAddr); err != nil {
+	var buf [8]byte
+	for i := uint32(0); i < methodList.Count; i++ {
+		var method objc.MethodSmallT
+		method.Get(mdat[int(i)*objc.MethodSmallTSize:], f.ByteOrder)
+		if _, err := f.sr.ReadAt(buf[:], currOffset+int64(method.NameOffset)); err != nil {
 			return nil, fmt.Errorf("failed to read nameAddr(small): %v", err)
 		}
+		nameVMAddr = f.ByteOrder.Uint64(buf[:])
 
 		if f.Flags.DylibInCache() {
 			nameVMAddr, err = f.vma.GetVMAddress(uint64(currOffset + int64(method.NameOffset)))
@@ -800,16 +1148,21 @@ func (f *File) readSmallMethods(methodList objc.MethodList) ([]objc.Method, erro
 	return objcMethods, nil
 }
 
-func (f *File) readBigMethods(methodList objc.MethodList) ([]objc.Method, error) {
+func (f *File) readBigMethods(methodList objc.MethodList, off int64) ([]objc.Method, error) {
 	// var m objc.Method
 	var objcMethods []objc.Method
 
-	methods := make([]objc.MethodT, methodList.Count)
-	if err := binary.Read(f.sr, f.ByteOrder, &methods); err != nil {
+	mdat, err := f.allocMethodEntries(methodList, objc.MethodTSize, off)
+	if err != nil {
+		return nil, err
+	}
+	if _, err := f.sr.ReadAt(mdat, off); err != nil {
 		return nil, fmt.Errorf("failed to read method_t: %v", err)
 	}
 
-	for _, method := range methods {
+	for i := uint32(0); i < methodList.Count; i++ {
+		var method objc.MethodT
+		method.Get(mdat[int(i)*objc.MethodTSize:], f.ByteOrder)
 		n, err := f.GetCString(f.vma.Convert(uint64(method.NameVMAddr)))
 		if err != nil {
 			return nil, fmt.Errorf("failed to read cstring: %v", err)
@@ -850,13 +1203,13 @@ func (f *File) GetObjCIvars(vmAddr uint64) ([]objc.Ivar, error) {
 		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 	}
 
-	f.sr.Seek(int64(off), io.SeekStart)
-	if err := binary.Read(f.sr, f.ByteOrder, &ivarsList); err != nil {
+	r := f.newReader(int64(off))
+	if err := binary.Read(r, f.ByteOrder, &ivarsList); err != nil {
 		return nil, fmt.Errorf("failed to read objc_ivar_list_t: %v", err)
 	}
 
 	ivs := make([]objc.IvarT, ivarsList.Count)
-	if err := binary.Read(f.sr, f.ByteOrder, &ivs); err != nil {
+	if err := binary.Read(r, f.ByteOrder, &ivs); err != nil {
 		return nil, fmt.Errorf("failed to read objc_ivar_list_t: %v", err)
 	}
 
@@ -866,10 +1219,8 @@ func (f *File) GetObjCIvars(vmAddr uint64) ([]objc.Ivar, error) {
 			return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 		}
 
-		f.sr.Seek(int64(off), io.SeekStart)
-
 		var o uint32
-		if err := binary.Read(f.sr, f.ByteOrder, &o); err != nil {
+		if err := binary.Read(f.newReader(int64(off)), f.ByteOrder, &o); err != nil {
 			return nil, fmt.Errorf("failed to read ivar.offset: %v", err)
 		}
 		n, err := f.GetCString(f.vma.Convert(uint64(ivar.NameVMAddr)))
@@ -901,13 +1252,13 @@ func (f *File) GetObjCProperties(vmAddr uint64) ([]objc.Property, error) {
 		return nil, fmt.Errorf("failed to convert vmaddr: %v", err)
 	}
 
-	f.sr.Seek(int64(off), io.SeekStart)
-	if err := binary.Read(f.sr, f.ByteOrder, &propList); err != nil {
+	r := f.newReader(int64(off))
+	if err := binary.Read(r, f.ByteOrder, &propList); err != nil {
 		return nil, fmt.Errorf("failed to read objc_property_list_t: %v", err)
 	}
 
 	properties := make([]objc.PropertyT, propList.Count)
-	if err := binary.Read(f.sr, f.ByteOrder, &properties); err != nil {
+	if err := binary.Read(r, f.ByteOrder, &properties); err != nil {
 		return nil, fmt.Errorf("failed to read objc_property_t: %v", err)
 	}
 
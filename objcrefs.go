@@ -0,0 +1,254 @@
+package macho
+
+import (
+	"fmt"
+	"sort"
+	"strings"
+)
+
+// ObjCRefKind is the __objc_*refs section a reference lives in
+type ObjCRefKind uint8
+
+const (
+	ObjCSelRef   ObjCRefKind = iota // __objc_selrefs
+	ObjCClassRef                    // __objc_classrefs
+	ObjCSuperRef                    // __objc_superrefs
+	ObjCProtoRef                    // __objc_protorefs
+	numObjCRefKinds
+)
+
+var objcRefSections = [numObjCRefKinds]string{"__objc_selrefs", "__objc_classrefs", "__objc_superrefs", "__objc_protorefs"}
+
+func (k ObjCRefKind) String() string {
+	if k < numObjCRefKinds {
+		return objcRefSections[k]
+	}
+	return fmt.Sprintf("ObjCRefKind(%d)", k)
+}
+
+// ObjCRef is a selector, class or protocol reference
+type ObjCRef struct {
+	Addr   uint64 // vmaddr of the reference
+	Target uint64 // vmaddr of the selector name, class or protocol (0 if bound to another image or unresolved)
+	Kind   ObjCRefKind
+	Name   string // selector, class or protocol name ("" if unresolved)
+}
+
+// objcRef is an ObjCRef with its name interned
+type objcRef struct {
+	addr   uint64
+	target uint64
+	name   uint32
+	kind   ObjCRefKind
+}
+
+// objcRefKey identifies the references of one kind to one name
+type objcRefKey struct {
+	kind ObjCRefKind
+	name uint32
+}
+
+// ObjCRefIndex indexes the __objc_*refs sections both ways: from a reference to what it references
+// and from a selector, class or protocol name to the addresses referencing it.
+type ObjCRefIndex struct {
+	refs   []objcRef                // sorted by addr
+	names  []string                 // interned names
+	ids    map[string]uint32        // name -> index in names
+	sites  []uint64                 // reference addresses grouped by kind and name
+	ranges map[objcRefKey][2]uint32 // sites[lo:hi] of each kind and name
+}
+
+// Len returns the number of references in the index
+func (x *ObjCRefIndex) Len() int {
+	return len(x.refs)
+}
+
+func (x *ObjCRefIndex) ref(r objcRef) ObjCRef {
+	return ObjCRef{Addr: r.addr, Target: r.target, Kind: r.kind, Name: x.names[r.name]}
+}
+
+// Ref returns the i-th reference in address order
+func (x *ObjCRefIndex) Ref(i int) ObjCRef {
+	return x.ref(x.refs[i])
+}
+
+// Lookup returns the reference at vmaddr addr
+func (x *ObjCRefIndex) Lookup(addr uint64) (ObjCRef, bool) {
+	i := sort.Search(len(x.refs), func(i int) bool { return x.refs[i].addr >= addr })
+	if i < len(x.refs) && x.refs[i].addr == addr {
+		return x.ref(x.refs[i]), true
+	}
+	return ObjCRef{}, false
+}
+
+// Refs returns the sorted addresses of the references of kind to name. The slice is shared and must not be modified.
+func (x *ObjCRefIndex) Refs(kind ObjCRefKind, name string) []uint64 {
+	id, ok := x.ids[name]
+	if !ok {
+		return nil
+	}
+	r, ok := x.ranges[objcRefKey{kind, id}]
+	if !ok {
+		return nil
+	}
+	return x.sites[r[0]:r[1]:r[1]]
+}
+
+// SelectorRefs returns the addresses of the __objc_selrefs entries for the selector name
+func (x *ObjCRefIndex) SelectorRefs(name string) []uint64 {
+	return x.Refs(ObjCSelRef, name)
+}
+
+// ClassRefs returns the addresses of the __objc_classrefs entries for the class name
+// (see Refs with ObjCSuperRef for the __objc_superrefs entries)
+func (x *ObjCRefIndex) ClassRefs(name string) []uint64 {
+	return x.Refs(ObjCClassRef, name)
+}
+
+// objcRefIndexBuilder resolves reference targets to interned names
+type objcRefIndexBuilder struct {
+	f       *File
+	x       *ObjCRefIndex
+	targets map[uint64]uint32 // pointer -> index in refs of its first reference in the current section
+}
+
+func (b *objcRefIndexBuilder) intern(name string) uint32 {
+	if id, ok := b.x.ids[name]; ok {
+		return id
+	}
+	id := uint32(len(b.x.names))
+	b.x.names = append(b.x.names, name)
+	b.x.ids[name] = id
+	return id
+}
+
+// resolve returns the vmaddr and name of what the pointer ptr of kind references
+func (b *objcRefIndexBuilder) resolve(kind ObjCRefKind, ptr uint64) (uint64, string, error) {
+	f := b.f
+	target := f.vma.Convert(ptr)
+	switch kind {
+	case ObjCSelRef:
+		name, err := f.GetCString(target)
+		if err != nil {
+			return 0, "", fmt.Errorf("failed to read cstring: %v", err)
+		}
+		return target, name, nil
+	case ObjCClassRef, ObjCSuperRef:
+		ref, err := f.getObjCClassRef(target)
+		if err == nil {
+			return target, ref.name, nil
+		}
+		bindName, err := f.GetBindName(ptr)
+		if err != nil {
+			return 0, "", fmt.Errorf("failed to read objc_class_t at %s ptr: %#x; %v", kind, ptr, err)
+		}
+		return 0, strings.TrimPrefix(bindName, "_OBJC_CLASS_$_"), nil
+	default:
+		off, err := f.vma.GetOffset(target)
+		if err != nil {
+			return 0, "", fmt.Errorf("failed to convert vmaddr: %v", err)
+		}
+		// protocol_t.name follows the isa
+		var buf [8]byte
+		if _, err := f.sr.ReadAt(buf[:], int64(off)+8); err != nil {
+			return 0, "", fmt.Errorf("failed to read protocol_t at protoref ptr: %#x; %v", ptr, err)
+		}
+		name, err := f.GetCString(f.vma.Convert(f.ByteOrder.Uint64(buf[:])))
+		if err != nil {
+			return 0, "", fmt.Errorf("failed to read cstring: %v", err)
+		}
+		return target, name, nil
+	}
+}
+
+// GetObjCRefIndex returns the index of the selector, class, super class and protocol references,
+// built once per File in a single pass over the __DATA*.__objc_*refs sections.
+// References that can't be resolved are indexed with an empty Name and a zero Target;
+// only failing to read a whole section is an error.
+func (f *File) GetObjCRefIndex() (*ObjCRefIndex, error) {
+	f.objcCache.indexOnce.Do(func() {
+		f.objcCache.index, f.objcCache.indexErr = f.buildObjCRefIndex()
+	})
+	return f.objcCache.index, f.objcCache.indexErr
+}
+
+func (f *File) buildObjCRefIndex() (*ObjCRefIndex, error) {
+	x := &ObjCRefIndex{ids: make(map[string]uint32)}
+	b := objcRefIndexBuilder{f: f, x: x}
+
+	var count uint64
+	var secs []*Section
+	var kinds []ObjCRefKind
+	for _, s := range f.Segments() {
+		if !strings.HasPrefix(s.Name, "__DATA") {
+			continue
+		}
+		for kind, name := range objcRefSections {
+			if sec := f.Section(s.Name, name); sec != nil {
+				secs = append(secs, sec)
+				kinds = append(kinds, ObjCRefKind(kind))
+				count += sec.Size / sizeOfInt64
+			}
+		}
+	}
+
+	x.refs = make([]objcRef, 0, count)
+	for i, sec := range secs {
+		kind := kinds[i]
+		dat, err := sec.Data()
+		if err != nil {
+			return nil, fmt.Errorf("failed to read %s.%s: %v", sec.Seg, sec.Name, err)
+		}
+		// a selector, class or protocol is usually referenced once per section; the cache is for the exceptions
+		b.targets = make(map[uint64]uint32)
+		for off := 0; off+sizeOfInt64 <= len(dat); off += sizeOfInt64 {
+			ptr := f.ByteOrder.Uint64(dat[off:])
+			ref := objcRef{addr: sec.Addr + uint64(off), kind: kind}
+			if id, ok := b.targets[ptr]; ok {
+				ref.target, ref.name = x.refs[id].target, x.refs[id].name
+			} else {
+				target, name, err := b.resolve(kind, ptr)
+				if err != nil {
+					// one bad pointer (e.g. stripped or corrupt) shouldn't hide every other reference
+					target, name = 0, ""
+				}
+				ref.target, ref.name = target, b.intern(name)
+				b.targets[ptr] = uint32(len(x.refs))
+			}
+			x.refs = append(x.refs, ref)
+		}
+	}
+
+	// group the reference addresses by kind and name for the reverse lookups
+	order := make([]uint32, len(x.refs))
+	for i := range order {
+		order[i] = uint32(i)
+	}
+	sort.Slice(order, func(i, j int) bool {
+		a, b := &x.refs[order[i]], &x.refs[order[j]]
+		if a.kind != b.kind {
+			return a.kind < b.kind
+		}
+		if a.name != b.name {
+			return a.name < b.name
+		}
+		return a.addr < b.addr
+	})
+	x.sites = make([]uint64, len(order))
+	x.ranges = make(map[objcRefKey][2]uint32)
+	for i, j := range order {
+		r := &x.refs[j]
+		x.sites[i] = r.addr
+		key := objcRefKey{r.kind, r.name}
+		rng, ok := x.ranges[key]
+		if !ok {
+			rng[0] = uint32(i)
+		}
+		rng[1] = uint32(i + 1)
+		x.ranges[key] = rng
+	}
+
+	sort.Slice(x.refs, func(i, j int) bool { return x.refs[i].addr < x.refs[j].addr })
+
+	return x, nil
+}
@@ -6,7 +6,10 @@ import (
 	"encoding/binary"
 	"fmt"
 	"io"
+	"runtime"
 	"strings"
+	"sync"
+	"sync/atomic"
 )
 
 // NewChainedFixups creates a new DyldChainedFixups instance
@@ -20,54 +23,165 @@ func NewChainedFixups(lcdat *bytes.Reader, sr *io.SectionReader, bo binary.ByteO
 
 // Parse parses a LC_DYLD_CHAINED_FIXUPS load command
 func (dcf *DyldChainedFixups) Parse() (*DyldChainedFixups, error) {
+	return dcf.ParseParallel(1)
+}
 
-	if dcf.Starts == nil {
-		if err := dcf.ParseStarts(); err != nil {
-			return nil, err
-		}
-	}
+// ParseParallel parses a LC_DYLD_CHAINED_FIXUPS load command walking the fixup chains of
+// different pages on up to workers goroutines (runtime.NumCPU() if workers <= 0).
+// The resulting Starts[].Fixups are identical to (and in the same order as) Parse's.
+func (dcf *DyldChainedFixups) ParseParallel(workers int) (*DyldChainedFixups, error) {
 
-	// Parse Imports
-	dcf.parseImports()
+	if err := dcf.prepareWalk(); err != nil {
+		return nil, err
+	}
 
-	for segIdx, start := range dcf.Starts {
+	if workers <= 0 {
+		workers = runtime.NumCPU()
+	}
 
-		if start.PageStarts == nil {
-			continue
+	if workers == 1 {
+		var buf []byte
+		for segIdx := range dcf.Starts {
+			start := &dcf.Starts[segIdx]
+			var err error
+			if buf, _, err = dcf.forEachSegmentFixup(segIdx, buf, func(fixup Fixup) bool {
+				start.Fixups = append(start.Fixups, fixup)
+				return true
+			}); err != nil {
+				return nil, err
+			}
 		}
+		return dcf, nil
+	}
 
-		for pageIndex := uint16(0); pageIndex < start.DyldChainedStartsInSegment.PageCount; pageIndex++ {
-			offsetInPage := start.PageStarts[pageIndex]
+	type pageJob struct {
+		segIdx    int
+		pageIndex uint16
+	}
 
-			if offsetInPage == DYLD_CHAINED_PTR_START_NONE {
-				continue
+	var jobs []pageJob
+	for segIdx, start := range dcf.Starts {
+		for pageIndex := uint16(0); pageIndex < uint16(len(start.PageStarts)); pageIndex++ {
+			if start.PageStarts[pageIndex] != DYLD_CHAINED_PTR_START_NONE {
+				jobs = append(jobs, pageJob{segIdx, pageIndex})
 			}
+		}
+	}
 
-			if offsetInPage&DYLD_CHAINED_PTR_START_MULTI != 0 {
-				// 32-bit chains which may need multiple starts per page
-				overflowIndex := offsetInPage & ^DYLD_CHAINED_PTR_START_MULTI
-				chainEnd := false
-				for !chainEnd {
-					chainEnd = (start.PageStarts[overflowIndex]&DYLD_CHAINED_PTR_START_LAST != 0)
-					offsetInPage = (start.PageStarts[overflowIndex] & ^DYLD_CHAINED_PTR_START_LAST)
-					if err := dcf.walkDcFixupChain(segIdx, pageIndex, offsetInPage); err != nil {
-						return nil, err
-					}
-					overflowIndex++
+	// each worker claims the next unwalked page and decodes it from its own page buffer;
+	// results are kept per page and concatenated in page order afterwards
+	results := make([][]Fixup, len(jobs))
+	errs := make([]error, len(jobs))
+	var next int64 = -1
+	var wg sync.WaitGroup
+	for w := 0; w < workers && w < len(jobs); w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			var buf []byte
+			for {
+				i := int(atomic.AddInt64(&next, 1))
+				if i >= len(jobs) {
+					return
 				}
-
-			} else {
-				// one chain per page
-				if err := dcf.walkDcFixupChain(segIdx, pageIndex, offsetInPage); err != nil {
-					return nil, err
+				start := &dcf.Starts[jobs[i].segIdx]
+				page, pageOff, err := dcf.readPage(&start.DyldChainedStartsInSegment, jobs[i].pageIndex, buf)
+				if err != nil {
+					errs[i] = err
+					continue
 				}
+				buf = page
+				_, errs[i] = dcf.walkPage(start, jobs[i].pageIndex, page, pageOff, func(fixup Fixup) bool {
+					results[i] = append(results[i], fixup)
+					return true
+				})
 			}
+		}()
+	}
+	wg.Wait()
+
+	counts := make([]int, len(dcf.Starts))
+	for i, job := range jobs {
+		if errs[i] != nil {
+			return nil, errs[i]
 		}
+		counts[job.segIdx] += len(results[i])
+	}
+	for segIdx, count := range counts {
+		if count > 0 {
+			dcf.Starts[segIdx].Fixups = make([]Fixup, 0, count)
+		}
+	}
+	for i, job := range jobs {
+		dcf.Starts[job.segIdx].Fixups = append(dcf.Starts[job.segIdx].Fixups, results[i]...)
 	}
 
 	return dcf, nil
 }
 
+// ForEachFixup decodes the fixup chains on the fly and calls fn for every fixup, in the same
+// order Parse would store them, until fn returns false. Nothing is retained in Starts[].Fixups
+// so callers that only count or filter fixups don't pay for materializing all of them.
+func (dcf *DyldChainedFixups) ForEachFixup(fn func(Fixup) bool) error {
+	if err := dcf.prepareWalk(); err != nil {
+		return err
+	}
+	var buf []byte
+	for segIdx := range dcf.Starts {
+		var ok bool
+		var err error
+		if buf, ok, err = dcf.forEachSegmentFixup(segIdx, buf, fn); !ok || err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// ForEachSegmentFixup is ForEachFixup limited to the segment at index segIdx of Starts
+func (dcf *DyldChainedFixups) ForEachSegmentFixup(segIdx int, fn func(Fixup) bool) error {
+	if err := dcf.prepareWalk(); err != nil {
+		return err
+	}
+	if segIdx < 0 || segIdx >= len(dcf.Starts) {
+		return fmt.Errorf("segment index %d out of range", segIdx)
+	}
+	_, _, err := dcf.forEachSegmentFixup(segIdx, nil, fn)
+	return err
+}
+
+// prepareWalk parses the starts and imports needed to decode chains if they haven't been yet
+func (dcf *DyldChainedFixups) prepareWalk() error {
+	if dcf.Starts == nil {
+		if err := dcf.ParseStarts(); err != nil {
+			return err
+		}
+	}
+	if dcf.Imports == nil && dcf.ImportsCount > 0 {
+		if err := dcf.parseImports(); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+func (dcf *DyldChainedFixups) forEachSegmentFixup(segIdx int, buf []byte, fn func(Fixup) bool) ([]byte, bool, error) {
+	start := &dcf.Starts[segIdx]
+	for pageIndex := uint16(0); pageIndex < uint16(len(start.PageStarts)); pageIndex++ {
+		if start.PageStarts[pageIndex] == DYLD_CHAINED_PTR_START_NONE {
+			continue
+		}
+		page, pageOff, err := dcf.readPage(&start.DyldChainedStartsInSegment, pageIndex, buf)
+		if err != nil {
+			return buf, false, err
+		}
+		buf = page
+		if ok, err := dcf.walkPage(start, pageIndex, page, pageOff, fn); !ok || err != nil {
+			return buf, false, err
+		}
+	}
+	return buf, true, nil
+}
+
 // ParseStarts parses the DyldChainedStartsInSegment(s)
 func (dcf *DyldChainedFixups) ParseStarts() error {
 
@@ -107,227 +221,172 @@ func (dcf *DyldChainedFixups) ParseStarts() error {
 	return nil
 }
 
-func (dcf *DyldChainedFixups) walkDcFixupChain(segIdx int, pageIndex uint16, offsetInPage DCPtrStart) error {
+// readPage reads page pageIndex of a segment into buf (growing it if needed) and returns the
+// page bytes and their file offset. The last page of a file may be short.
+func (dcf *DyldChainedFixups) readPage(seg *DyldChainedStartsInSegment, pageIndex uint16, buf []byte) ([]byte, uint64, error) {
+	pageOff := seg.SegmentOffset + uint64(pageIndex)*uint64(seg.PageSize)
+	if cap(buf) < int(seg.PageSize) {
+		buf = make([]byte, seg.PageSize)
+	}
+	n, err := dcf.sr.ReadAt(buf[:seg.PageSize], int64(pageOff))
+	if err != nil && err != io.EOF {
+		return nil, 0, fmt.Errorf("failed to read fixup page at offset %#x: %v", pageOff, err)
+	}
+	return buf[:n], pageOff, nil
+}
 
-	var dcPtr uint32
-	var dcPtr64 uint64
-	var next uint64
+// walkPage decodes every fixup chain that starts on page pageIndex of start from page (the
+// page's bytes at file offset pageOff), calling fn for each fixup until fn returns false
+func (dcf *DyldChainedFixups) walkPage(start *DyldChainedStarts, pageIndex uint16, page []byte, pageOff uint64, fn func(Fixup) bool) (bool, error) {
+	offsetInPage := start.PageStarts[pageIndex]
 
-	chainEnd := false
-	segOffset := dcf.Starts[segIdx].DyldChainedStartsInSegment.SegmentOffset
-	pageContentStart := segOffset + uint64(pageIndex)*uint64(dcf.Starts[segIdx].DyldChainedStartsInSegment.PageSize)
+	if offsetInPage&DYLD_CHAINED_PTR_START_MULTI == 0 {
+		// one chain per page
+		return dcf.walkChain(start.PointerFormat, page, pageOff, offsetInPage, fn)
+	}
 
-	for !chainEnd {
-		fixupLocation := pageContentStart + uint64(offsetInPage) + next
-		dcf.sr.Seek(int64(fixupLocation), io.SeekStart)
+	// 32-bit chains which may need multiple starts per page
+	overflowIndex := offsetInPage & ^DYLD_CHAINED_PTR_START_MULTI
+	for {
+		if int(overflowIndex) >= len(start.PageStarts) {
+			return false, fmt.Errorf("chain start overflow index %d out of range", overflowIndex)
+		}
+		chainEnd := start.PageStarts[overflowIndex]&DYLD_CHAINED_PTR_START_LAST != 0
+		offsetInPage = start.PageStarts[overflowIndex] & ^DYLD_CHAINED_PTR_START_LAST
+		if ok, err := dcf.walkChain(start.PointerFormat, page, pageOff, offsetInPage, fn); !ok || err != nil {
+			return ok, err
+		}
+		if chainEnd {
+			return true, nil
+		}
+		overflowIndex++
+	}
+}
+
+// readPtr returns the size byte pointer at loc within page; pointers that lie past the end
+// of the page buffer are read from the file
+func (dcf *DyldChainedFixups) readPtr(page []byte, pageOff, loc uint64, size int) (uint64, error) {
+	if loc+uint64(size) <= uint64(len(page)) {
+		if size == 4 {
+			return uint64(dcf.bo.Uint32(page[loc:])), nil
+		}
+		return dcf.bo.Uint64(page[loc:]), nil
+	}
+	var buf [8]byte
+	if _, err := dcf.sr.ReadAt(buf[:size], int64(pageOff+loc)); err != nil {
+		return 0, err
+	}
+	if size == 4 {
+		return uint64(dcf.bo.Uint32(buf[:])), nil
+	}
+	return dcf.bo.Uint64(buf[:]), nil
+}
 
-		pointerFormat := dcf.Starts[segIdx].DyldChainedStartsInSegment.PointerFormat
+// arm64eFixup returns the rebase or bind fixup encoded in an arm64e chained pointer
+func (dcf *DyldChainedFixups) arm64eFixup(dcPtr64, fixupLocation uint64) Fixup {
+	if !DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
+		return DyldChainedPtrArm64eRebase{Pointer: dcPtr64, Fixup: fixupLocation}
+	} else if DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
+		bind := DyldChainedPtrArm64eBind{Pointer: dcPtr64, Fixup: fixupLocation}
+		bind.Import = dcf.Imports[bind.Ordinal()].Name
+		return bind
+	} else if !DcpArm64eIsBind(dcPtr64) && DcpArm64eIsAuth(dcPtr64) {
+		return DyldChainedPtrArm64eAuthRebase{Pointer: dcPtr64, Fixup: fixupLocation}
+	}
+	bind := DyldChainedPtrArm64eAuthBind{Pointer: dcPtr64, Fixup: fixupLocation}
+	bind.Import = dcf.Imports[bind.Ordinal()].Name
+	return bind
+}
+
+// walkChain decodes the fixup chain starting at offsetInPage, calling fn for each fixup.
+// It returns false if fn stopped the walk.
+func (dcf *DyldChainedFixups) walkChain(pointerFormat DCPtrKind, page []byte, pageOff uint64, offsetInPage DCPtrStart, fn func(Fixup) bool) (bool, error) {
+	var next uint64
+
+	for {
+		loc := uint64(offsetInPage) + next
+		fixupLocation := pageOff + loc
+
+		var fixup Fixup
+		var delta uint64
 
 		switch pointerFormat {
-		case DYLD_CHAINED_PTR_32:
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr); err != nil {
-				return err
+		case DYLD_CHAINED_PTR_32, DYLD_CHAINED_PTR_32_CACHE, DYLD_CHAINED_PTR_32_FIRMWARE:
+			ptr, err := dcf.readPtr(page, pageOff, loc, 4)
+			if err != nil {
+				return false, err
 			}
-			if Generic32IsBind(dcPtr) {
+			dcPtr := uint32(ptr)
+			switch {
+			case pointerFormat == DYLD_CHAINED_PTR_32_CACHE:
+				fixup = DyldChainedPtr32CacheRebase{Pointer: dcPtr, Fixup: fixupLocation}
+			case pointerFormat == DYLD_CHAINED_PTR_32_FIRMWARE:
+				fixup = DyldChainedPtr32FirmwareRebase{Pointer: dcPtr, Fixup: fixupLocation}
+			case Generic32IsBind(dcPtr):
 				bind := DyldChainedPtr32Bind{Pointer: dcPtr, Fixup: fixupLocation}
 				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
-			} else {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtr32Rebase{
-					Pointer: dcPtr,
-					Fixup:   fixupLocation,
-				})
+				fixup = bind
+			default:
+				fixup = DyldChainedPtr32Rebase{Pointer: dcPtr, Fixup: fixupLocation}
 			}
-			if Generic32Next(dcPtr) == 0 {
-				chainEnd = true
+			delta = Generic32Next(dcPtr)
+		case DYLD_CHAINED_PTR_64, DYLD_CHAINED_PTR_64_OFFSET, DYLD_CHAINED_PTR_64_KERNEL_CACHE, DYLD_CHAINED_PTR_X86_64_KERNEL_CACHE:
+			dcPtr64, err := dcf.readPtr(page, pageOff, loc, 8)
+			if err != nil {
+				return false, err
 			}
-			next += Generic32Next(dcPtr) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_32_CACHE:
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr); err != nil {
-				return err
-			}
-			dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtr32CacheRebase{
-				Pointer: dcPtr,
-				Fixup:   fixupLocation,
-			})
-			if Generic32Next(dcPtr) == 0 {
-				chainEnd = true
-			}
-			next += Generic32Next(dcPtr) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_32_FIRMWARE:
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr); err != nil {
-				return err
-			}
-			dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtr32FirmwareRebase{
-				Pointer: dcPtr,
-				Fixup:   fixupLocation,
-			})
-			if Generic32Next(dcPtr) == 0 {
-				chainEnd = true
-			}
-			next += Generic32Next(dcPtr) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_64: // target is vmaddr
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
-			}
-			if Generic64IsBind(dcPtr64) {
+			switch {
+			case pointerFormat == DYLD_CHAINED_PTR_64_OFFSET: // target is vm offset
+				fixup = DyldChainedPtr64RebaseOffset{Pointer: dcPtr64, Fixup: fixupLocation}
+			case pointerFormat != DYLD_CHAINED_PTR_64: // kernel caches
+				fixup = DyldChainedPtr64KernelCacheRebase{Pointer: dcPtr64, Fixup: fixupLocation}
+			case Generic64IsBind(dcPtr64): // target is vmaddr
 				bind := DyldChainedPtr64Bind{Pointer: dcPtr64, Fixup: fixupLocation}
 				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
-			} else {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtr64Rebase{
-					Pointer: dcPtr64,
-					Fixup:   fixupLocation,
-				})
-			}
-			if Generic64Next(dcPtr64) == 0 {
-				chainEnd = true
-			}
-			next += Generic64Next(dcPtr64) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_64_OFFSET: // target is vm offset
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
-			}
-			dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtr64RebaseOffset{
-				Pointer: dcPtr64,
-				Fixup:   fixupLocation,
-			})
-			if Generic64Next(dcPtr64) == 0 {
-				chainEnd = true
-			}
-			next += Generic64Next(dcPtr64) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_64_KERNEL_CACHE:
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
-			}
-			dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtr64KernelCacheRebase{
-				Pointer: dcPtr64,
-				Fixup:   fixupLocation,
-			})
-			if Generic64Next(dcPtr64) == 0 {
-				chainEnd = true
-			}
-			next += Generic64Next(dcPtr64) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_X86_64_KERNEL_CACHE: // stride 1, x86_64 kernel caches
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
-			}
-			dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtr64KernelCacheRebase{
-				Pointer: dcPtr64,
-				Fixup:   fixupLocation,
-			})
-			if Generic64Next(dcPtr64) == 0 {
-				chainEnd = true
-			}
-			next += Generic64Next(dcPtr64) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_ARM64E_KERNEL: // stride 4, unauth target is vm offset
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
-			}
-			if !DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtrArm64eRebase{
-					Pointer: dcPtr64,
-					Fixup:   fixupLocation,
-				})
-			} else if DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
-				bind := DyldChainedPtrArm64eBind{Pointer: dcPtr64, Fixup: fixupLocation}
-				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
-			} else if !DcpArm64eIsBind(dcPtr64) && DcpArm64eIsAuth(dcPtr64) {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtrArm64eAuthRebase{
-					Pointer: dcPtr64,
-					Fixup:   fixupLocation,
-				})
-			} else {
-				bind := DyldChainedPtrArm64eAuthBind{Pointer: dcPtr64, Fixup: fixupLocation}
-				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
-			}
-			if DcpArm64eNext(dcPtr64) == 0 {
-				chainEnd = true
-			}
-			next += DcpArm64eNext(dcPtr64) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_ARM64E_FIRMWARE: // stride 4, unauth target is vmaddr
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
-			}
-			if !DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtrArm64eRebase{
-					Pointer: dcPtr64,
-					Fixup:   fixupLocation,
-				})
-			} else if DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
-				bind := DyldChainedPtrArm64eBind{Pointer: dcPtr64, Fixup: fixupLocation}
-				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
-			} else if !DcpArm64eIsBind(dcPtr64) && DcpArm64eIsAuth(dcPtr64) {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtrArm64eAuthRebase{
-					Pointer: dcPtr64,
-					Fixup:   fixupLocation,
-				})
-			} else {
-				bind := DyldChainedPtrArm64eAuthBind{Pointer: dcPtr64, Fixup: fixupLocation}
-				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
+				fixup = bind
+			default:
+				fixup = DyldChainedPtr64Rebase{Pointer: dcPtr64, Fixup: fixupLocation}
 			}
-			if DcpArm64eNext(dcPtr64) == 0 {
-				chainEnd = true
+			delta = Generic64Next(dcPtr64)
+		case DYLD_CHAINED_PTR_ARM64E_KERNEL, // stride 4, unauth target is vm offset
+			DYLD_CHAINED_PTR_ARM64E_FIRMWARE, // stride 4, unauth target is vmaddr
+			DYLD_CHAINED_PTR_ARM64E,          // stride 8, unauth target is vmaddr
+			DYLD_CHAINED_PTR_ARM64E_USERLAND: // stride 8, unauth target is vm offset
+			dcPtr64, err := dcf.readPtr(page, pageOff, loc, 8)
+			if err != nil {
+				return false, err
 			}
-			next += DcpArm64eNext(dcPtr64) * stride(pointerFormat)
-		case DYLD_CHAINED_PTR_ARM64E: // stride 8, unauth target is vmaddr
-			fallthrough
-		case DYLD_CHAINED_PTR_ARM64E_USERLAND: // stride 8, unauth target is vm offset
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
-			}
-			if !DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtrArm64eRebase{
-					Pointer: dcPtr64,
-					Fixup:   fixupLocation,
-				})
-			} else if DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
-				bind := DyldChainedPtrArm64eBind{Pointer: dcPtr64, Fixup: fixupLocation}
-				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
-			} else if !DcpArm64eIsBind(dcPtr64) && DcpArm64eIsAuth(dcPtr64) {
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, DyldChainedPtrArm64eAuthRebase{
-					Pointer: dcPtr64,
-					Fixup:   fixupLocation,
-				})
-			} else {
-				bind := DyldChainedPtrArm64eAuthBind{Pointer: dcPtr64, Fixup: fixupLocation}
-				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
-			}
-			if DcpArm64eNext(dcPtr64) == 0 {
-				chainEnd = true
-			}
-			next += DcpArm64eNext(dcPtr64) * stride(pointerFormat)
+			fixup = dcf.arm64eFixup(dcPtr64, fixupLocation)
+			delta = DcpArm64eNext(dcPtr64)
 		case DYLD_CHAINED_PTR_ARM64E_USERLAND24: // stride 8, unauth target is vm offset, 24-bit bind
-			if err := binary.Read(dcf.sr, dcf.bo, &dcPtr64); err != nil {
-				return err
+			dcPtr64, err := dcf.readPtr(page, pageOff, loc, 8)
+			if err != nil {
+				return false, err
 			}
 			if DcpArm64eIsBind(dcPtr64) && DcpArm64eIsAuth(dcPtr64) {
 				bind := DyldChainedPtrArm64eAuthBind24{Pointer: dcPtr64, Fixup: fixupLocation}
 				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
+				fixup = bind
 			} else if DcpArm64eIsBind(dcPtr64) && !DcpArm64eIsAuth(dcPtr64) {
 				bind := DyldChainedPtrArm64eBind24{Pointer: dcPtr64, Fixup: fixupLocation}
 				bind.Import = dcf.Imports[bind.Ordinal()].Name
-				dcf.Starts[segIdx].Fixups = append(dcf.Starts[segIdx].Fixups, bind)
+				fixup = bind
 			} else {
-				return fmt.Errorf("unknown DYLD_CHAINED_PTR_ARM64E_USERLAND24 pointer typr 0x%04X", dcPtr64)
-			}
-			if DcpArm64eNext(dcPtr64) == 0 {
-				chainEnd = true
+				return false, fmt.Errorf("unknown DYLD_CHAINED_PTR_ARM64E_USERLAND24 pointer typr 0x%04X", dcPtr64)
 			}
-			next += DcpArm64eNext(dcPtr64) * stride(pointerFormat)
+			delta = DcpArm64eNext(dcPtr64)
 		default:
-			return fmt.Errorf("unknown pointer format %#04X", dcf.Starts[segIdx].DyldChainedStartsInSegment.PointerFormat)
+			return false, fmt.Errorf("unknown pointer format %#04X", pointerFormat)
 		}
-	}
 
-	return nil
+		if !fn(fixup) {
+			return false, nil
+		}
+		if delta == 0 {
+			return true, nil
+		}
+		next += delta * stride(pointerFormat)
+	}
 }
 
 func (dcf *DyldChainedFixups) parseImports() error {
@@ -0,0 +1,173 @@
+package fixupchains
+
+import (
+	"bytes"
+	"encoding/binary"
+	"io"
+	"reflect"
+	"testing"
+)
+
+const testPageSize = 0x1000
+
+// synthChainedFixups builds a LC_DYLD_CHAINED_FIXUPS payload and a matching segment with
+// one DYLD_CHAINED_PTR_64 chain of perPage pointers (alternating rebases and binds) per page
+func synthChainedFixups(pages, perPage int) (*bytes.Reader, *io.SectionReader) {
+	bo := binary.LittleEndian
+
+	seg := make([]byte, pages*testPageSize)
+	pageStarts := make([]uint16, pages)
+	for p := 0; p < pages; p++ {
+		pageStarts[p] = 0x10
+		for i := 0; i < perPage; i++ {
+			var ptr uint64
+			if i%2 == 0 {
+				ptr = 0x100000000 + uint64(p*testPageSize+i*16) // rebase target
+			} else {
+				ptr = 1<<63 | uint64(i%3) // bind to import ordinal i%3
+			}
+			if i < perPage-1 {
+				ptr |= 4 << 51 // next pointer is 16 bytes (4 * stride 4) on
+			}
+			bo.PutUint64(seg[p*testPageSize+0x10+i*16:], ptr)
+		}
+	}
+
+	var lc bytes.Buffer
+	const hdrSize = 28
+	startsSize := 4 + 4 + 22 + 2*pages
+	symbols := []byte("_a\x00_b\x00_c\x00")
+	binary.Write(&lc, bo, DyldChainedFixupsHeader{
+		StartsOffset:  hdrSize,
+		ImportsOffset: uint32(hdrSize + startsSize),
+		SymbolsOffset: uint32(hdrSize + startsSize + 3*4),
+		ImportsCount:  3,
+		ImportsFormat: DC_IMPORT,
+	})
+	binary.Write(&lc, bo, uint32(1)) // seg_count
+	binary.Write(&lc, bo, uint32(8)) // seg_info_offset[0]
+	binary.Write(&lc, bo, DyldChainedStartsInSegment{
+		Size:          uint32(22 + 2*pages),
+		PageSize:      testPageSize,
+		PointerFormat: DYLD_CHAINED_PTR_64,
+		PageCount:     uint16(pages),
+	})
+	binary.Write(&lc, bo, pageStarts)
+	for i := 0; i < 3; i++ {
+		binary.Write(&lc, bo, uint32(1|(i*3)<<9)) // lib ordinal 1, name offset
+	}
+	lc.Write(symbols)
+
+	return bytes.NewReader(lc.Bytes()), io.NewSectionReader(bytes.NewReader(seg), 0, int64(len(seg)))
+}
+
+func TestParseParallel(t *testing.T) {
+	const pages, perPage = 64, 32
+
+	lcdat, sr := synthChainedFixups(pages, perPage)
+	want, err := NewChainedFixups(lcdat, sr, binary.LittleEndian).Parse()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if n := len(want.Starts[0].Fixups); n != pages*perPage {
+		t.Fatalf("Parse found %d fixups; want %d", n, pages*perPage)
+	}
+	if b, ok := want.Starts[0].Fixups[1].(DyldChainedPtr64Bind); !ok || b.Import != "_b" {
+		t.Errorf("Parse: second fixup = %v; want bind to _b", want.Starts[0].Fixups[1])
+	}
+
+	for _, workers := range []int{0, 2, 7} {
+		lcdat, sr := synthChainedFixups(pages, perPage)
+		got, err := NewChainedFixups(lcdat, sr, binary.LittleEndian).ParseParallel(workers)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !reflect.DeepEqual(got.Starts, want.Starts) {
+			t.Errorf("ParseParallel(%d) fixups differ from Parse", workers)
+		}
+	}
+}
+
+func TestForEachFixup(t *testing.T) {
+	const pages, perPage = 16, 32
+
+	lcdat, sr := synthChainedFixups(pages, perPage)
+	want, err := NewChainedFixups(lcdat, sr, binary.LittleEndian).Parse()
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	lcdat, sr = synthChainedFixups(pages, perPage)
+	dcf := NewChainedFixups(lcdat, sr, binary.LittleEndian)
+	var got []Fixup
+	if err := dcf.ForEachFixup(func(fixup Fixup) bool {
+		got = append(got, fixup)
+		return true
+	}); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(got, want.Starts[0].Fixups) {
+		t.Error("ForEachFixup fixups differ from Parse")
+	}
+	if dcf.Starts[0].Fixups != nil {
+		t.Error("ForEachFixup retained fixups in Starts")
+	}
+
+	var n int
+	if err := dcf.ForEachSegmentFixup(0, func(fixup Fixup) bool {
+		n++
+		return n < 5
+	}); err != nil {
+		t.Fatal(err)
+	}
+	if n != 5 {
+		t.Errorf("ForEachSegmentFixup visited %d fixups after stopping at 5", n)
+	}
+
+	// the imports ForEachFixup parsed are reused, not parsed again
+	got2, err := dcf.ParseParallel(2)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(got2.Imports) != len(want.Imports) {
+		t.Errorf("ParseParallel after ForEachFixup: %d imports; want %d", len(got2.Imports), len(want.Imports))
+	}
+	if !reflect.DeepEqual(got2.Starts, want.Starts) {
+		t.Error("ParseParallel after ForEachFixup: fixups differ from Parse")
+	}
+}
+
+func BenchmarkForEachFixup(b *testing.B) {
+	lcdat, sr := synthChainedFixups(1024, 128)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		lcdat.Seek(0, io.SeekStart)
+		var n int
+		if err := NewChainedFixups(lcdat, sr, binary.LittleEndian).ForEachFixup(func(Fixup) bool {
+			n++
+			return true
+		}); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkParse(b *testing.B) {
+	for _, bm := range []struct {
+		name    string
+		workers int
+	}{{"serial", 1}, {"parallel", 0}} {
+		b.Run(bm.name, func(b *testing.B) {
+			lcdat, sr := synthChainedFixups(1024, 128)
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				lcdat.Seek(0, io.SeekStart)
+				if _, err := NewChainedFixups(lcdat, sr, binary.LittleEndian).ParseParallel(bm.workers); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
@@ -0,0 +1,195 @@
+package trie
+
+import (
+	"fmt"
+	"sort"
+	"strings"
+)
+
+// buildNode is a node of the trie being built; nodes are kept in pre-order, the order they are emitted in
+type buildNode struct {
+	termStart uint32 // terminal info is terms[termStart:termEnd]
+	termEnd   uint32
+	edges     uint32 // edges[edges:edges+nedges]
+	nedges    uint32
+	off       uint32 // offset of the node in the output
+}
+
+// buildEdge is an edge of the trie being built
+type buildEdge struct {
+	label string
+	child uint32
+	lo    uint32 // range of the sorted entries below the edge
+	hi    uint32
+}
+
+type builder struct {
+	entries     []TrieEntry
+	order       []int32 // entries sorted by name
+	loadAddress uint64
+	nodes       []buildNode
+	edges       []buildEdge
+	terms       []byte
+}
+
+func appendUleb128(b []byte, v uint64) []byte {
+	for v >= 0x80 {
+		b = append(b, byte(v)|0x80)
+		v >>= 7
+	}
+	return append(b, byte(v))
+}
+
+func uleb128Size(v uint64) uint32 {
+	n := uint32(1)
+	for ; v >= 0x80; v >>= 7 {
+		n++
+	}
+	return n
+}
+
+func (b *builder) name(i uint32) string {
+	return b.entries[b.order[i]].Name
+}
+
+// appendTerminal appends the terminal info of e, the inverse of decodeTerminal
+func (b *builder) appendTerminal(e *TrieEntry) {
+	b.terms = appendUleb128(b.terms, uint64(e.Flags))
+	switch {
+	case e.Flags.ReExport():
+		b.terms = appendUleb128(b.terms, e.Other)
+		b.terms = append(append(b.terms, e.ReExport...), 0)
+	case e.Flags.StubAndResolver():
+		b.terms = appendUleb128(b.terms, e.Other-b.loadAddress)
+		b.terms = appendUleb128(b.terms, e.Address-b.loadAddress)
+	case e.Flags.Regular() || e.Flags.ThreadLocal():
+		b.terms = appendUleb128(b.terms, e.Address-b.loadAddress)
+	default:
+		b.terms = appendUleb128(b.terms, e.Address)
+	}
+}
+
+// build adds the subtree for the sorted entries [lo, hi), which share their first depth bytes
+func (b *builder) build(lo, hi uint32, depth int) uint32 {
+	idx := uint32(len(b.nodes))
+	b.nodes = append(b.nodes, buildNode{})
+	n := &b.nodes[idx]
+
+	if len(b.name(lo)) == depth {
+		n.termStart = uint32(len(b.terms))
+		b.appendTerminal(&b.entries[b.order[lo]])
+		n.termEnd = uint32(len(b.terms))
+		lo++
+	}
+
+	// one edge per run of names sharing their next byte, labeled with the run's common prefix
+	n.edges = uint32(len(b.edges))
+	for lo < hi {
+		first := b.name(lo)
+		c := first[depth]
+		j := lo + 1
+		for j < hi && b.name(j)[depth] == c {
+			j++
+		}
+		last := b.name(j - 1)
+		lcp := depth + 1
+		for lcp < len(first) && lcp < len(last) && first[lcp] == last[lcp] {
+			lcp++
+		}
+		b.edges = append(b.edges, buildEdge{label: first[depth:lcp], lo: lo, hi: j})
+		lo = j
+	}
+	n.nedges = uint32(len(b.edges)) - n.edges
+
+	for e, end := b.nodes[idx].edges, b.nodes[idx].edges+b.nodes[idx].nedges; e < end; e++ {
+		child := b.build(b.edges[e].lo, b.edges[e].hi, depth+len(b.edges[e].label))
+		b.edges[e].child = child
+	}
+
+	return idx
+}
+
+// size returns the encoded size of n given the current child offsets
+func (b *builder) size(n *buildNode) uint32 {
+	termSize := n.termEnd - n.termStart
+	sz := uleb128Size(uint64(termSize)) + termSize + 1
+	for _, e := range b.edges[n.edges : n.edges+n.nedges] {
+		sz += uint32(len(e.label)) + 1 + uleb128Size(uint64(b.nodes[e.child].off))
+	}
+	return sz
+}
+
+// layout assigns node offsets. Offsets are ULEB128 encoded so a node's size depends on the
+// offsets of its children; start from zero and grow the offsets until they stop changing.
+func (b *builder) layout() (uint32, error) {
+	for {
+		var off uint64
+		changed := false
+		for i := range b.nodes {
+			n := &b.nodes[i]
+			if uint64(n.off) != off {
+				n.off = uint32(off)
+				changed = true
+			}
+			off += uint64(b.size(n))
+			if off > 1<<32-1 {
+				return 0, fmt.Errorf("export trie is too large (> 4GB)")
+			}
+		}
+		if !changed {
+			return uint32(off), nil
+		}
+	}
+}
+
+// BuildTrie serializes entries into a dyld export trie, the inverse of ParseTrie.
+// Addresses are absolute and are stored relative to loadAddress (except for absolute symbols);
+// FoundInDylib is ignored. The output is not padded to pointer alignment.
+func BuildTrie(entries []TrieEntry, loadAddress uint64) ([]byte, error) {
+	b := &builder{
+		entries:     entries,
+		order:       make([]int32, len(entries)),
+		loadAddress: loadAddress,
+	}
+	for i := range b.order {
+		if strings.IndexByte(entries[i].Name, 0) >= 0 {
+			return nil, fmt.Errorf("failed to build export trie: symbol %q contains a NUL byte", entries[i].Name)
+		}
+		b.order[i] = int32(i)
+	}
+	sort.Slice(b.order, func(i, j int) bool {
+		return entries[b.order[i]].Name < entries[b.order[j]].Name
+	})
+	for i := 1; i < len(b.order); i++ {
+		if entries[b.order[i]].Name == entries[b.order[i-1]].Name {
+			return nil, fmt.Errorf("failed to build export trie: duplicate symbol %q", entries[b.order[i]].Name)
+		}
+	}
+
+	if len(entries) == 0 {
+		return []byte{0, 0}, nil // empty root
+	}
+
+	b.nodes = make([]buildNode, 0, 2*len(entries))
+	b.edges = make([]buildEdge, 0, 2*len(entries))
+	b.build(0, uint32(len(entries)), 0)
+
+	size, err := b.layout()
+	if err != nil {
+		return nil, err
+	}
+
+	out := make([]byte, 0, size)
+	for i := range b.nodes {
+		n := &b.nodes[i]
+		out = appendUleb128(out, uint64(n.termEnd-n.termStart))
+		out = append(out, b.terms[n.termStart:n.termEnd]...)
+		out = append(out, byte(n.nedges))
+		for _, e := range b.edges[n.edges : n.edges+n.nedges] {
+			out = append(append(out, e.label...), 0)
+			out = appendUleb128(out, uint64(b.nodes[e.child].off))
+		}
+	}
+
+	return out, nil
+}
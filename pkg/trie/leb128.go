@@ -0,0 +1,136 @@
+package trie
+
+import (
+	"encoding/binary"
+	"io"
+	"math/bits"
+)
+
+const (
+	lebContinue = 0x8080808080808080 // continuation bit of each byte in a word
+	lebPayload  = 0x7f7f7f7f7f7f7f7f
+)
+
+// gatherUleb128 packs the 7 bit groups of a little endian word holding a whole ULEB128 value
+// (bytes past the value and continuation bits cleared)
+func gatherUleb128(w uint64) uint64 {
+	return w&0x7f |
+		w>>1&(0x7f<<7) |
+		w>>2&(0x7f<<14) |
+		w>>3&(0x7f<<21) |
+		w>>4&(0x7f<<28) |
+		w>>5&(0x7f<<35) |
+		w>>6&(0x7f<<42) |
+		w>>7&(0x7f<<49)
+}
+
+// ReadUleb128At decodes the ULEB128 value at data[off:] and returns it with the offset just past it.
+// It returns io.EOF if data ends before the value does.
+func ReadUleb128At(data []byte, off int) (uint64, int, error) {
+	if off < 0 || off >= len(data) {
+		return 0, off, io.EOF
+	}
+
+	// 1 and 2 byte values (function start deltas, trie offsets and flags) are the common case
+	b := data[off]
+	if b < 0x80 {
+		return uint64(b), off + 1, nil
+	}
+	if off+1 < len(data) && data[off+1] < 0x80 {
+		return uint64(b&0x7f) | uint64(data[off+1])<<7, off + 2, nil
+	}
+
+	// values of up to 8 bytes are decoded from a single word
+	if off+8 <= len(data) {
+		w := binary.LittleEndian.Uint64(data[off:])
+		if stop := ^w & lebContinue; stop != 0 {
+			n := bits.TrailingZeros64(stop)/8 + 1
+			if n < 8 {
+				w &= 1<<(8*uint(n)) - 1
+			}
+			return gatherUleb128(w & lebPayload), off + n, nil
+		}
+	}
+
+	var result uint64
+	var shift uint
+	for {
+		if off >= len(data) {
+			return 0, off, io.EOF
+		}
+		b := data[off]
+		off++
+		if shift < 64 {
+			result |= uint64(b&0x7f) << shift
+		}
+		if b&0x80 == 0 {
+			return result, off, nil
+		}
+		shift += 7
+	}
+}
+
+// ReadSleb128At decodes the SLEB128 value at data[off:] and returns it with the offset just past it.
+// It returns io.EOF if data ends before the value does.
+func ReadSleb128At(data []byte, off int) (int64, int, error) {
+	if off < 0 || off >= len(data) {
+		return 0, off, io.EOF
+	}
+
+	b := data[off]
+	if b < 0x80 {
+		return int64(int8(b<<1)) >> 1, off + 1, nil // sign extend bit 6
+	}
+
+	var result uint64
+	var shift uint
+	for {
+		if off >= len(data) {
+			return 0, off, io.EOF
+		}
+		b = data[off]
+		off++
+		if shift < 64 {
+			result |= uint64(b&0x7f) << shift
+		}
+		shift += 7
+		if b&0x80 == 0 {
+			break
+		}
+	}
+	if shift < 64 && b&0x40 != 0 {
+		result |= ^uint64(0) << shift
+	}
+	return int64(result), off, nil
+}
+
+// DecodeUleb128s decodes a stream of ULEB128 values (e.g. LC_FUNCTION_STARTS deltas).
+// If the stream ends in the middle of a value the values before it are returned with io.ErrUnexpectedEOF.
+func DecodeUleb128s(data []byte) ([]uint64, error) {
+	// every value ends with exactly one byte without the continuation bit
+	var n int
+	i := 0
+	for ; i+8 <= len(data); i += 8 {
+		n += bits.OnesCount64(^binary.LittleEndian.Uint64(data[i:]) & lebContinue)
+	}
+	for ; i < len(data); i++ {
+		if data[i] < 0x80 {
+			n++
+		}
+	}
+
+	vals := make([]uint64, n)
+	off := 0
+	for k := range vals {
+		v, next, err := ReadUleb128At(data, off)
+		if err != nil {
+			return vals[:k], io.ErrUnexpectedEOF
+		}
+		vals[k] = v
+		off = next
+	}
+	if off < len(data) {
+		return vals, io.ErrUnexpectedEOF // trailing bytes with the continuation bit set
+	}
+	return vals, nil
+}
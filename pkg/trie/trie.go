@@ -2,9 +2,11 @@ package trie
 
 import (
 	"bytes"
+	"errors"
 	"fmt"
 	"io"
 	"path/filepath"
+	"sort"
 
 	"github.com/blacktop/go-macho/types"
 )
@@ -26,11 +28,6 @@ type trieEntrys struct {
 	r *bytes.Reader
 }
 
-type trieNode struct {
-	Offset   uint64
-	SymBytes []byte
-}
-
 func (e TrieEntry) String() string {
 	if e.Flags.ReExport() {
 		return fmt.Sprintf("%#016x: %s (%s re-exported from %s)", e.Address, e.Name, e.ReExport, filepath.Base(e.FoundInDylib))
@@ -100,219 +97,327 @@ func ReadUleb128FromBuffer(buf *bytes.Buffer) (uint64, int, error) {
 	return result, length, nil
 }
 
-func ParseTrie(trieData []byte, loadAddress uint64) ([]TrieEntry, error) {
+// cstringEnd returns the offset of the NUL terminating the string at data[off:] (or len(data))
+func cstringEnd(data []byte, off int) int {
+	if off >= len(data) {
+		return len(data)
+	}
+	if i := bytes.IndexByte(data[off:], 0); i >= 0 {
+		return off + i
+	}
+	return len(data)
+}
 
-	var tNode trieNode
+// trieFrame is a pending node: its offset and the edge (data[edgeStart:edgeEnd]) that
+// extends its parent's prefix (prefix[:parentLen]) to its own
+type trieFrame struct {
+	node      int
+	parentLen int
+	edgeStart int
+	edgeEnd   int
+}
+
+// ErrStopWalk can be returned by a Walk callback to stop the walk early without an error
+var ErrStopWalk = errors.New("stop walk")
+
+// ParseTrie parses the export trie in trieData and returns every exported symbol
+func ParseTrie(trieData []byte, loadAddress uint64) ([]TrieEntry, error) {
 	var entries []TrieEntry
+	if err := walk(trieData, loadAddress, "", func(e TrieEntry) error {
+		entries = append(entries, e)
+		return nil
+	}); err != nil {
+		return nil, err
+	}
+	return entries, nil
+}
 
-	nodes := []trieNode{{
-		Offset:   0,
-		SymBytes: make([]byte, 0),
-	}}
+// Walk calls fn for every exported symbol in trieData as it is decoded.
+// If fn returns ErrStopWalk the walk stops and Walk returns nil; any other error is returned as is.
+func Walk(trieData []byte, loadAddress uint64, fn func(TrieEntry) error) error {
+	return walk(trieData, loadAddress, "", fn)
+}
 
-	r := bytes.NewReader(trieData)
+// WalkPrefix is like Walk but only visits symbols starting with prefix;
+// subtrees whose edges cannot lead to such a symbol are skipped.
+func WalkPrefix(trieData []byte, loadAddress uint64, prefix string, fn func(TrieEntry) error) error {
+	return walk(trieData, loadAddress, prefix, fn)
+}
 
-	for len(nodes) > 0 {
-		tNode, nodes = nodes[len(nodes)-1], nodes[:len(nodes)-1]
+// decodeTerminal decodes the terminal info at trieData[off:] into e
+func decodeTerminal(trieData []byte, off int, loadAddress uint64, e *TrieEntry) error {
+	symFlagInt, off, err := ReadUleb128At(trieData, off)
+	if err != nil {
+		return err
+	}
 
-		r.Seek(int64(tNode.Offset), io.SeekStart)
+	e.Flags = types.ExportFlag(symFlagInt)
 
-		terminalSize, err := ReadUleb128(r)
+	if e.Flags.ReExport() {
+		e.Other, off, err = ReadUleb128At(trieData, off)
 		if err != nil {
-			return nil, err
+			return err
 		}
+		// re-exports have no address; the terminal ends with the imported name
+		e.ReExport = string(trieData[off:cstringEnd(trieData, off)])
+		return nil
+	}
 
-		if terminalSize != 0 {
-			var symFlagInt, symValueInt, symOtherInt uint64
-			var reExportSymBytes []byte
-			var symName string
-			var reExportSymName string
+	if e.Flags.StubAndResolver() {
+		e.Other, off, err = ReadUleb128At(trieData, off)
+		if err != nil {
+			return err
+		}
+		e.Other += loadAddress
+	}
 
-			symFlagInt, err := ReadUleb128(r)
-			if err != nil {
-				return nil, err
-			}
+	e.Address, _, err = ReadUleb128At(trieData, off)
+	if err != nil {
+		return err
+	}
 
-			flags := types.ExportFlag(symFlagInt)
+	if e.Flags.Regular() || e.Flags.ThreadLocal() {
+		e.Address += loadAddress
+	}
 
-			if flags.ReExport() {
-				symOtherInt, err = ReadUleb128(r)
-				if err != nil {
-					return nil, err
-				}
+	return nil
+}
 
-				for {
-					s, err := r.ReadByte()
-					if err == io.EOF {
-						break
-					}
-					if s == '\x00' {
-						break
-					}
-					reExportSymBytes = append(reExportSymBytes, s)
-				}
+// edgeMatches reports whether the edge data[start:end] appended to a prefix of length depth
+// (which already agrees with match) can still lead to a name starting with match
+func edgeMatches(data []byte, start, end, depth int, match string) bool {
+	if depth >= len(match) {
+		return true
+	}
+	rest := match[depth:]
+	edge := data[start:end]
+	if len(edge) > len(rest) {
+		edge = edge[:len(rest)]
+	}
+	return string(edge) == rest[:len(edge)]
+}
+
+// walk is a depth first traversal over trieData that keeps a single prefix buffer; edges are
+// only referenced by offset until a terminal node is reached. Only subtrees that can contain
+// names starting with match are visited.
+func walk(trieData []byte, loadAddress uint64, match string, fn func(TrieEntry) error) error {
+	prefix := make([]byte, 0, 256)
+	stack := []trieFrame{{}}
+	visited := 0
+
+	for len(stack) > 0 {
+		fr := stack[len(stack)-1]
+		stack = stack[:len(stack)-1]
+
+		// every frame below parentLen on the stack is an ancestor, so prefix[:parentLen] is still the parent's prefix
+		prefix = append(prefix[:fr.parentLen], trieData[fr.edgeStart:fr.edgeEnd]...)
+
+		if visited++; visited > len(trieData) {
+			return fmt.Errorf("possible malformed export trie: visited more nodes than trie bytes (%d)", len(trieData))
+		}
+
+		terminalSize, off, err := ReadUleb128At(trieData, fr.node)
+		if err != nil {
+			return err
+		}
+		if terminalSize >= uint64(len(trieData)) {
+			return fmt.Errorf("possible malformed export trie: terminal size %#x beyond trie size %#x", terminalSize, len(trieData))
+		}
+		children := off + int(terminalSize)
 
-			} else if flags.StubAndResolver() {
-				symOtherInt, err = ReadUleb128(r)
-				if err != nil {
-					return nil, err
+		if terminalSize != 0 && len(prefix) >= len(match) {
+			e := TrieEntry{Name: string(prefix)}
+			if err := decodeTerminal(trieData, off, loadAddress, &e); err != nil {
+				return err
+			}
+			if err := fn(e); err != nil {
+				if err == ErrStopWalk {
+					return nil
 				}
-				symOtherInt += loadAddress
+				return err
 			}
+		}
+
+		if children >= len(trieData) {
+			break
+		}
+		childrenRemaining := int(trieData[children])
+		off = children + 1
+
+		if childrenRemaining > 0 && len(prefix) > 32768 {
+			return fmt.Errorf("possible malformed export trie: len(tNode.SymBytes)=%d > 32768", len(prefix))
+		}
 
-			symValueInt, err = ReadUleb128(r)
+		for i := 0; i < childrenRemaining; i++ {
+			edgeStart := off
+			edgeEnd := cstringEnd(trieData, off)
+
+			childNodeOffset, next, err := ReadUleb128At(trieData, edgeEnd+1)
 			if err != nil {
-				return nil, err
+				return err
 			}
+			off = next
 
-			if (flags.Regular() || flags.ThreadLocal()) && !flags.ReExport() {
-				symValueInt += loadAddress
+			if childNodeOffset >= uint64(len(trieData)) {
+				return fmt.Errorf("possible malformed export trie: child node offset %#x beyond trie size %#x", childNodeOffset, len(trieData))
 			}
 
-			if len(reExportSymBytes) > 0 {
-				symName = string(tNode.SymBytes)
-				reExportSymName = string(reExportSymBytes)
-			} else {
-				symName = string(tNode.SymBytes)
+			if !edgeMatches(trieData, edgeStart, edgeEnd, len(prefix), match) {
+				continue
 			}
 
-			entries = append(entries, TrieEntry{
-				Name:     symName,
-				ReExport: reExportSymName,
-				Flags:    flags,
-				Other:    symOtherInt,
-				Address:  symValueInt,
+			stack = append(stack, trieFrame{
+				node:      int(childNodeOffset),
+				parentLen: len(prefix),
+				edgeStart: edgeStart,
+				edgeEnd:   edgeEnd,
 			})
 		}
+	}
 
-		r.Seek(int64(tNode.Offset+terminalSize+1), io.SeekStart)
+	return nil
+}
 
-		childrenRemaining, err := r.ReadByte()
-		if err == io.EOF {
-			break
-		}
+// LookupSymbols resolves the sorted symbols in a single traversal of the trie; each edge is
+// decoded once for all the symbols that share it. entries[i] holds the export of symbols[i]
+// and has an empty Name if symbols[i] is not in the trie.
+func LookupSymbols(trieData []byte, loadAddress uint64, symbols []string) ([]TrieEntry, error) {
+	if !sort.StringsAreSorted(symbols) {
+		return nil, fmt.Errorf("symbols must be sorted")
+	}
+	entries := make([]TrieEntry, len(symbols))
+	if len(symbols) == 0 || len(trieData) == 0 {
+		return entries, nil
+	}
+	if err := lookupSymbols(trieData, loadAddress, 0, 0, symbols, entries); err != nil {
+		return nil, err
+	}
+	return entries, nil
+}
 
-		for i := 0; i < int(childrenRemaining); i++ {
+// lookupSymbols resolves symbols (sorted, all sharing the first depth bytes) in the subtree at node
+func lookupSymbols(trieData []byte, loadAddress uint64, node, depth int, symbols []string, entries []TrieEntry) error {
+	terminalSize, off, err := ReadUleb128At(trieData, node)
+	if err != nil {
+		return err
+	}
+	if terminalSize >= uint64(len(trieData)) {
+		return fmt.Errorf("possible malformed export trie: terminal size %#x beyond trie size %#x", terminalSize, len(trieData))
+	}
+	children := off + int(terminalSize)
 
-			if len(tNode.SymBytes) > 32768 {
-				return nil, fmt.Errorf("possible malformed export trie: len(tNode.SymBytes)=%d > 32768", len(tNode.SymBytes))
+	// names ending here sort first
+	for len(symbols) > 0 && len(symbols[0]) == depth {
+		if terminalSize != 0 {
+			entries[0].Name = symbols[0]
+			if err := decodeTerminal(trieData, off, loadAddress, &entries[0]); err != nil {
+				return err
 			}
+		}
+		symbols, entries = symbols[1:], entries[1:]
+	}
 
-			tmp := make([]byte, len(tNode.SymBytes), 32768)
-			copy(tmp, tNode.SymBytes)
+	if len(symbols) == 0 || children >= len(trieData) {
+		return nil
+	}
+	childrenRemaining := int(trieData[children])
+	off = children + 1
 
-			for {
-				s, err := r.ReadByte()
-				if err == io.EOF {
-					break
-				}
-				if s == '\x00' {
-					break
-				}
-				tmp = append(tmp, s)
-			}
+	// symbols are sorted so their next bytes span [first, last]
+	first, last := symbols[0][depth], symbols[len(symbols)-1][depth]
+	remaining := len(symbols)
 
-			childNodeOffset, err := ReadUleb128(r)
-			if err != nil {
-				return nil, err
-			}
+	for i := 0; i < childrenRemaining && remaining > 0; i++ {
+		edgeStart := off
+		edgeEnd := cstringEnd(trieData, off)
 
-			// log.WithFields(log.Fields{
-			// 	"name":   string(tmp),
-			// 	"offset": childNodeOffset,
-			// }).Debug("Node")
+		childNodeOffset, next, err := ReadUleb128At(trieData, edgeEnd+1)
+		if err != nil {
+			return err
+		}
+		off = next
 
-			nodes = append(nodes, trieNode{
-				Offset:   childNodeOffset,
-				SymBytes: tmp,
-			})
+		if childNodeOffset >= uint64(len(trieData)) {
+			return fmt.Errorf("possible malformed export trie: child node offset %#x beyond trie size %#x", childNodeOffset, len(trieData))
+		}
+		edge := trieData[edgeStart:edgeEnd]
+		if len(edge) == 0 {
+			return fmt.Errorf("possible malformed export trie: empty edge at offset %#x", edgeStart)
+		}
+		if edge[0] < first || edge[0] > last {
+			continue
+		}
+
+		// the symbols continuing with edge are a contiguous run of the sorted symbols
+		lo := sort.Search(len(symbols), func(j int) bool {
+			return symbols[j][depth:] >= string(edge)
+		})
+		hi := lo
+		for hi < len(symbols) && len(symbols[hi]) >= depth+len(edge) && symbols[hi][depth:depth+len(edge)] == string(edge) {
+			hi++
+		}
+		if lo == hi {
+			continue
 		}
+		remaining -= hi - lo
 
+		if err := lookupSymbols(trieData, loadAddress, int(childNodeOffset), depth+len(edge), symbols[lo:hi], entries[lo:hi]); err != nil {
+			return err
+		}
 	}
 
-	return entries, nil
+	return nil
 }
 
+// WalkTrie follows symbol down the trie and returns the offset of its terminal info
+// (just past the node's terminal size); use LookupSymbols to decode many symbols at once.
 func WalkTrie(data []byte, symbol string) (uint64, error) {
+	var strIndex, offset int
 
-	var strIndex int
-	var offset, nodeOffset uint64
-
-	r := bytes.NewReader(data)
-
-	for {
-		r.Seek(int64(offset), io.SeekStart)
-
-		terminalSize, err := ReadUleb128(r)
+	for depth := 0; depth <= len(data); depth++ {
+		terminalSize, off, err := ReadUleb128At(data, offset)
 		if err != nil {
 			return 0, err
 		}
 
-		if int(strIndex) == len(symbol) && (terminalSize != 0) {
-			// skip over zero terminator
-			return offset + 1, nil
+		if strIndex == len(symbol) && terminalSize != 0 {
+			return uint64(off), nil
 		}
 
-		r.Seek(int64(offset+terminalSize+1), io.SeekStart)
-
-		childrenRemaining, err := r.ReadByte()
-		if err == io.EOF {
+		if terminalSize >= uint64(len(data)) {
+			return 0, fmt.Errorf("possible malformed export trie: terminal size %#x beyond trie size %#x", terminalSize, len(data))
+		}
+		children := off + int(terminalSize)
+		if children >= len(data) {
 			break
 		}
+		childrenRemaining := int(data[children])
+		off = children + 1
 
-		nodeOffset = 0
+		nodeOffset := 0
+		for i := 0; i < childrenRemaining; i++ {
+			edgeEnd := cstringEnd(data, off)
+			edge := data[off:edgeEnd]
 
-		for i := childrenRemaining; i > 0; i-- {
-			searchStrIndex := strIndex
-			wrongEdge := false
-
-			for {
-				c, err := r.ReadByte()
-				if err == io.EOF {
-					break
-				}
-				if c == '\x00' {
-					break
-				}
-				if !wrongEdge {
-					if searchStrIndex != len(symbol) && c != symbol[searchStrIndex] {
-						wrongEdge = true
-					}
-					searchStrIndex++
-					if searchStrIndex > len(symbol) {
-						return offset, fmt.Errorf("symbol not in trie")
-					}
-				}
+			childNodeOffset, next, err := ReadUleb128At(data, edgeEnd+1)
+			if err != nil {
+				return 0, err
 			}
+			off = next
 
-			if wrongEdge {
-				// advance to next child
-				r.Seek(1, io.SeekCurrent) // skip over zero terminator
-				// skip over last byte of uleb128
-				_, err = ReadUleb128(r)
-				if err != nil {
-					return 0, err
-				}
-			} else {
-				// the symbol so far matches this edge (child)
-				// so advance to the child's node
-				// r.Seek(1, io.SeekCurrent)
-				nodeOffset, err = ReadUleb128(r)
-				if err != nil {
-					return 0, err
-				}
-
-				strIndex = searchStrIndex
+			if len(edge) > 0 && len(symbol)-strIndex >= len(edge) && symbol[strIndex:strIndex+len(edge)] == string(edge) {
+				// the symbol so far matches this edge (child) so advance to the child's node
+				nodeOffset = int(childNodeOffset)
+				strIndex += len(edge)
 				break
 			}
 		}
 
-		if nodeOffset != 0 {
-			offset = nodeOffset
-		} else {
+		if nodeOffset == 0 {
 			break
 		}
+		offset = nodeOffset
 	}
 
-	return offset, fmt.Errorf("symbol not in trie")
+	return uint64(offset), fmt.Errorf("symbol not in trie")
 }
@@ -0,0 +1,432 @@
+package trie
+
+import (
+	"bytes"
+	"errors"
+	"fmt"
+	"io"
+	"math"
+	"math/rand"
+	"reflect"
+	"sort"
+	"strings"
+	"testing"
+
+	"github.com/blacktop/go-macho/types"
+)
+
+const testLoadAddress = 0x100000000
+
+// handTrie is an export trie written out by hand (independent of BuildTrie) with a regular,
+// a re-exported and a stub and resolver symbol under a shared "_" edge
+var handTrie = []byte{
+	0x00, 0x01, '_', 0x00, 0x05, // root
+	0x00, 0x03, 'a', 0x00, 0x10, 'b', 0x00, 0x15, 'c', 0x00, 0x1e, // _
+	0x03, 0x00, 0x80, 0x20, 0x00, // _a: regular at 0x1000
+	0x07, 0x08, 0x02, '_', 'b', 'a', 'r', 0x00, 0x00, // _b: re-export of _bar from ordinal 2
+	0x05, 0x10, 0x80, 0x40, 0x80, 0x60, 0x00, // _c: stub at 0x2000, resolver at 0x3000
+}
+
+// handTrieEntries are the entries of handTrie sorted by name
+var handTrieEntries = []TrieEntry{
+	{Name: "_a", Address: testLoadAddress + 0x1000},
+	{Name: "_b", Flags: types.EXPORT_SYMBOL_FLAGS_REEXPORT, Other: 2, ReExport: "_bar"},
+	{Name: "_c", Flags: types.EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER, Other: testLoadAddress + 0x2000, Address: testLoadAddress + 0x3000},
+}
+
+// synthTrie returns an export trie of n symbols and the entries ParseTrie should return for it
+func synthTrie(tb testing.TB, n int) ([]byte, []TrieEntry) {
+	tb.Helper()
+	entries := make([]TrieEntry, n)
+	for i := range entries {
+		e := TrieEntry{Address: testLoadAddress + 0x4000 + uint64(i)*16}
+		switch i % 4 {
+		case 0:
+			e.Name = fmt.Sprintf("_OBJC_CLASS_$_Class%d", i)
+		case 1:
+			e.Name = fmt.Sprintf("_$s10Foundation4Type%dV4namexvg", i)
+		default:
+			e.Name = fmt.Sprintf("_func_%08x", i)
+		}
+		switch i % 32 {
+		case 3:
+			e.Flags = types.EXPORT_SYMBOL_FLAGS_REEXPORT
+			e.Other = uint64(i%5 + 1)
+			e.ReExport = fmt.Sprintf("_imported_%d", i)
+			e.Address = 0
+		case 7:
+			e.Flags = types.EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER
+			e.Other = testLoadAddress + 0x1000 + uint64(i)
+		case 11:
+			e.Flags = types.EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL
+		}
+		entries[i] = e
+	}
+	sort.Slice(entries, func(i, j int) bool { return entries[i].Name < entries[j].Name })
+
+	data, err := BuildTrie(entries, testLoadAddress)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return data, entries
+}
+
+func appendSleb128(b []byte, v int64) []byte {
+	for {
+		c := byte(v & 0x7f)
+		v >>= 7
+		if (v == 0 && c&0x40 == 0) || (v == -1 && c&0x40 != 0) {
+			return append(b, c)
+		}
+		b = append(b, c|0x80)
+	}
+}
+
+// synthUlebStream returns n ULEB128 values, mostly 1 and 2 bytes long like function start deltas
+func synthUlebStream(n int) ([]byte, []uint64) {
+	rnd := rand.New(rand.NewSource(1))
+	vals := make([]uint64, n)
+	var data []byte
+	for i := range vals {
+		switch i % 16 {
+		case 0:
+			vals[i] = rnd.Uint64() >> uint(rnd.Intn(64))
+		case 1, 2, 3:
+			vals[i] = uint64(rnd.Intn(1 << 14))
+		default:
+			vals[i] = uint64(rnd.Intn(1 << 7))
+		}
+		data = appendUleb128(data, vals[i])
+	}
+	return data, vals
+}
+
+func TestLeb128(t *testing.T) {
+	data, want := synthUlebStream(10000)
+	for _, v := range []uint64{1<<56 - 1, 1 << 56, 1<<63 - 1, math.MaxUint64} {
+		data = appendUleb128(data, v)
+		want = append(want, v)
+	}
+
+	got, err := DecodeUleb128s(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(got, want) {
+		t.Error("DecodeUleb128s differs from the encoded values")
+	}
+
+	r := bytes.NewReader(data)
+	for i, off := 0, 0; off < len(data); i++ {
+		v, next, err := ReadUleb128At(data, off)
+		if err != nil {
+			t.Fatal(err)
+		}
+		rv, err := ReadUleb128(r)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if v != want[i] || rv != v {
+			t.Fatalf("value %d: ReadUleb128At = %#x, ReadUleb128 = %#x; want %#x", i, v, rv, want[i])
+		}
+		off = next
+	}
+
+	if _, _, err := ReadUleb128At([]byte{0x80, 0x80}, 0); err != io.EOF {
+		t.Errorf("ReadUleb128At of a truncated value returned %v; want io.EOF", err)
+	}
+	if vals, err := DecodeUleb128s([]byte{0x01, 0x80}); err != io.ErrUnexpectedEOF || len(vals) != 1 {
+		t.Errorf("DecodeUleb128s of a truncated stream returned %v, %v; want [1], io.ErrUnexpectedEOF", vals, err)
+	}
+
+	for _, v := range []int64{0, 1, -1, 63, -64, 64, -65, 1 << 20, -(1 << 20), math.MaxInt64, math.MinInt64} {
+		enc := appendSleb128(nil, v)
+		got, next, err := ReadSleb128At(enc, 0)
+		if err != nil || got != v || next != len(enc) {
+			t.Errorf("ReadSleb128At(% x) = %d, %d, %v; want %d, %d", enc, got, next, err, v, len(enc))
+		}
+	}
+}
+
+func BenchmarkReadUleb128(b *testing.B) {
+	data, vals := synthUlebStream(100000)
+	b.Run("reader", func(b *testing.B) {
+		b.SetBytes(int64(len(data)))
+		for i := 0; i < b.N; i++ {
+			r := bytes.NewReader(data)
+			for range vals {
+				if _, err := ReadUleb128(r); err != nil {
+					b.Fatal(err)
+				}
+			}
+		}
+	})
+	b.Run("slice", func(b *testing.B) {
+		b.SetBytes(int64(len(data)))
+		for i := 0; i < b.N; i++ {
+			for off := 0; off < len(data); {
+				_, next, err := ReadUleb128At(data, off)
+				if err != nil {
+					b.Fatal(err)
+				}
+				off = next
+			}
+		}
+	})
+	b.Run("batch", func(b *testing.B) {
+		b.SetBytes(int64(len(data)))
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := DecodeUleb128s(data); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
+
+func TestBuildTrie(t *testing.T) {
+	got, err := BuildTrie([]TrieEntry{
+		{Name: "_ab", Address: 0x2000},
+		{Name: "_a", Address: 0x1000},
+	}, 0)
+	if err != nil {
+		t.Fatal(err)
+	}
+	want := []byte{
+		0x00, 0x01, '_', 'a', 0x00, 0x06, // root
+		0x03, 0x00, 0x80, 0x20, 0x01, 'b', 0x00, 0x0e, // _a
+		0x03, 0x00, 0x80, 0x40, 0x00, // _ab
+	}
+	if !reflect.DeepEqual(got, want) {
+		t.Errorf("BuildTrie = % x; want % x", got, want)
+	}
+
+	if _, err := BuildTrie([]TrieEntry{{Name: "_a"}, {Name: "_a"}}, 0); err == nil {
+		t.Error("BuildTrie of duplicate symbols did not fail")
+	}
+
+	// round trip a trie large enough for multi-byte child offsets
+	data, entries := synthTrie(t, 50000)
+	parsed, err := ParseTrie(data, testLoadAddress)
+	if err != nil {
+		t.Fatal(err)
+	}
+	rebuilt, err := BuildTrie(parsed, testLoadAddress)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(rebuilt, data) {
+		t.Error("BuildTrie(ParseTrie(trie)) differs from trie")
+	}
+	sort.Slice(parsed, func(i, j int) bool { return parsed[i].Name < parsed[j].Name })
+	if !reflect.DeepEqual(parsed, entries) {
+		t.Error("ParseTrie(BuildTrie(entries)) differs from entries")
+	}
+}
+
+func BenchmarkBuildTrie(b *testing.B) {
+	for _, n := range []int{10000, 100000, 1000000} {
+		b.Run(fmt.Sprint(n), func(b *testing.B) {
+			_, entries := synthTrie(b, n)
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				if _, err := BuildTrie(entries, testLoadAddress); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+func TestParseTrie(t *testing.T) {
+	hand, err := ParseTrie(handTrie, testLoadAddress)
+	if err != nil {
+		t.Fatal(err)
+	}
+	sort.Slice(hand, func(i, j int) bool { return hand[i].Name < hand[j].Name })
+	if !reflect.DeepEqual(hand, handTrieEntries) {
+		t.Errorf("ParseTrie(handTrie) = %+v; want %+v", hand, handTrieEntries)
+	}
+
+	data, want := synthTrie(t, 5000)
+
+	got, err := ParseTrie(data, testLoadAddress)
+	if err != nil {
+		t.Fatal(err)
+	}
+	sort.Slice(got, func(i, j int) bool { return got[i].Name < got[j].Name })
+	if !reflect.DeepEqual(got, want) {
+		t.Errorf("ParseTrie returned %d entries that differ from the %d in the trie", len(got), len(want))
+	}
+
+	if _, err := ParseTrie(data[:len(data)/2], testLoadAddress); err == nil {
+		t.Error("ParseTrie of a truncated trie did not fail")
+	}
+
+	loop := []byte{0, 1, 'a', 0, 0} // root with an edge back to itself
+	if _, err := ParseTrie(loop, 0); err == nil {
+		t.Error("ParseTrie of a looping trie did not fail")
+	}
+}
+
+func TestWalk(t *testing.T) {
+	var hand []TrieEntry
+	if err := WalkPrefix(handTrie, testLoadAddress, "_b", func(e TrieEntry) error {
+		hand = append(hand, e)
+		return nil
+	}); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(hand, handTrieEntries[1:2]) {
+		t.Errorf("WalkPrefix(handTrie, _b) = %+v; want %+v", hand, handTrieEntries[1:2])
+	}
+
+	data, want := synthTrie(t, 5000)
+
+	var n int
+	if err := Walk(data, testLoadAddress, func(e TrieEntry) error {
+		n++
+		return nil
+	}); err != nil {
+		t.Fatal(err)
+	}
+	if n != len(want) {
+		t.Errorf("Walk visited %d entries; want %d", n, len(want))
+	}
+
+	const prefix = "_OBJC_CLASS_$_Class1"
+	var wantPrefix, gotPrefix []TrieEntry
+	for _, e := range want {
+		if strings.HasPrefix(e.Name, prefix) {
+			wantPrefix = append(wantPrefix, e)
+		}
+	}
+	if err := WalkPrefix(data, testLoadAddress, prefix, func(e TrieEntry) error {
+		gotPrefix = append(gotPrefix, e)
+		return nil
+	}); err != nil {
+		t.Fatal(err)
+	}
+	sort.Slice(gotPrefix, func(i, j int) bool { return gotPrefix[i].Name < gotPrefix[j].Name })
+	if len(wantPrefix) == 0 || !reflect.DeepEqual(gotPrefix, wantPrefix) {
+		t.Errorf("WalkPrefix(%q) returned %d entries; want %d", prefix, len(gotPrefix), len(wantPrefix))
+	}
+
+	n = 0
+	if err := Walk(data, testLoadAddress, func(e TrieEntry) error {
+		if n++; n == 10 {
+			return ErrStopWalk
+		}
+		return nil
+	}); err != nil || n != 10 {
+		t.Errorf("Walk stopped after %d entries with %v; want 10 and nil", n, err)
+	}
+
+	errBoom := errors.New("boom")
+	if err := Walk(data, testLoadAddress, func(e TrieEntry) error { return errBoom }); err != errBoom {
+		t.Errorf("Walk returned %v; want the callback error", err)
+	}
+}
+
+func BenchmarkWalkPrefix(b *testing.B) {
+	data, _ := synthTrie(b, 100000)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := WalkPrefix(data, testLoadAddress, "_OBJC_CLASS_$_Class99", func(TrieEntry) error {
+			return nil
+		}); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func TestLookupSymbols(t *testing.T) {
+	data, entries := synthTrie(t, 5000)
+
+	var symbols []string
+	var want []TrieEntry
+	for i := 0; i < len(entries); i += 7 {
+		symbols = append(symbols, entries[i].Name)
+		want = append(want, entries[i])
+		missing := entries[i].Name + "_missing"
+		symbols = append(symbols, missing, entries[i].Name[:len(entries[i].Name)-1])
+		want = append(want, TrieEntry{}, TrieEntry{})
+	}
+	symbols = append(symbols, "")
+	want = append(want, TrieEntry{})
+	order := make([]int, len(symbols))
+	for i := range order {
+		order[i] = i
+	}
+	sort.SliceStable(order, func(i, j int) bool { return symbols[order[i]] < symbols[order[j]] })
+	sorted := make([]string, len(symbols))
+	for i, o := range order {
+		sorted[i] = symbols[o]
+	}
+
+	got, err := LookupSymbols(data, testLoadAddress, sorted)
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i, o := range order {
+		w := want[o]
+		// a truncated name can itself be an export (e.g. _func_00000010 -> _func_0000001)
+		if w.Name == "" && got[i].Name != "" {
+			j := sort.Search(len(entries), func(j int) bool { return entries[j].Name >= sorted[i] })
+			if j < len(entries) && entries[j].Name == sorted[i] {
+				w = entries[j]
+			}
+		}
+		if !reflect.DeepEqual(got[i], w) {
+			t.Fatalf("LookupSymbols(%q) = %v; want %v", sorted[i], got[i], w)
+		}
+	}
+
+	if _, err := LookupSymbols(data, testLoadAddress, []string{"b", "a"}); err == nil {
+		t.Error("LookupSymbols of unsorted symbols did not fail")
+	}
+}
+
+func BenchmarkLookupSymbols(b *testing.B) {
+	data, entries := synthTrie(b, 100000)
+	var symbols []string
+	for i := 0; i < len(entries); i += 10 {
+		symbols = append(symbols, entries[i].Name)
+	}
+	b.Run("batched", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := LookupSymbols(data, testLoadAddress, symbols); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("one-by-one", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			for _, sym := range symbols {
+				if _, err := WalkTrie(data, sym); err != nil {
+					b.Fatal(err)
+				}
+			}
+		}
+	})
+}
+
+func BenchmarkParseTrie(b *testing.B) {
+	for _, n := range []int{10000, 100000, 1000000} {
+		b.Run(fmt.Sprint(n), func(b *testing.B) {
+			data, _ := synthTrie(b, n)
+			b.SetBytes(int64(len(data)))
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				if _, err := ParseTrie(data, testLoadAddress); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
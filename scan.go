@@ -0,0 +1,252 @@
+package macho
+
+import (
+	"encoding/binary"
+	"fmt"
+	"io"
+	"os"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/blacktop/go-macho/types"
+)
+
+// ScanOptions configures Scan
+type ScanOptions struct {
+	// Workers is the number of files opened concurrently (default runtime.NumCPU())
+	Workers int
+	// MaxMemory bounds the total size of the files open at once; a file larger than
+	// the budget is opened on its own (0 means unlimited)
+	MaxMemory int64
+	// MaxOpenFiles bounds the number of file descriptors held at once; each worker holds
+	// at most one so Workers is capped to it (default Workers)
+	MaxOpenFiles int
+	// Mmap maps files into memory instead of reading them (see OpenMmap)
+	Mmap bool
+	// FileConfig is passed to NewFile for thin files and every architecture of fat files
+	FileConfig FileConfig
+}
+
+// ScanResult reports how scanning one path went
+type ScanResult struct {
+	Path    string
+	Size    int64
+	Fat     bool
+	Files   int           // number of Files passed to the callback (architectures for fat files)
+	Skipped bool          // not a Mach-O file
+	Parse   time.Duration // time spent parsing
+	Total   time.Duration // wall time for the path including waiting for the memory and file limits and the callback
+	Err     error         // the first open, parse or callback error
+}
+
+// scanKind is what sniffMagic found at the start of a file
+type scanKind int
+
+const (
+	scanSkip scanKind = iota
+	scanThin
+	scanFat
+)
+
+// sniffMagic classifies r by its first 4 bytes
+func sniffMagic(r io.ReaderAt) (scanKind, error) {
+	var ident [4]byte
+	if _, err := r.ReadAt(ident[:], 0); err != nil {
+		if err == io.EOF {
+			return scanSkip, nil
+		}
+		return scanSkip, err
+	}
+	be := binary.BigEndian.Uint32(ident[:])
+	le := binary.LittleEndian.Uint32(ident[:])
+	switch {
+	case be == types.MagicFat.Int():
+		return scanFat, nil
+	case be&^1 == types.Magic32.Int()&^1, le&^1 == types.Magic32.Int()&^1:
+		return scanThin, nil
+	}
+	return scanSkip, nil
+}
+
+// memBudget is a counting semaphore over bytes
+type memBudget struct {
+	sync.Mutex
+	cond  *sync.Cond
+	max   int64
+	inUse int64
+}
+
+func newMemBudget(max int64) *memBudget {
+	b := &memBudget{max: max}
+	b.cond = sync.NewCond(&b.Mutex)
+	return b
+}
+
+// acquire blocks until n bytes fit in the budget; n is clamped to the budget so large files run alone
+func (b *memBudget) acquire(n int64) int64 {
+	if b.max <= 0 {
+		return 0
+	}
+	if n > b.max {
+		n = b.max
+	}
+	b.Lock()
+	for b.inUse+n > b.max {
+		b.cond.Wait()
+	}
+	b.inUse += n
+	b.Unlock()
+	return n
+}
+
+func (b *memBudget) release(n int64) {
+	if n == 0 {
+		return
+	}
+	b.Lock()
+	b.inUse -= n
+	b.Unlock()
+	b.cond.Broadcast()
+}
+
+// scanner holds the state shared by the Scan workers
+type scanner struct {
+	opts ScanOptions
+	fn   func(string, *File) error
+	mem  *memBudget
+}
+
+// Scan opens every path that is a thin or fat Mach-O file and calls fn with each of its Files
+// (one per architecture for fat files). Paths are handed out to a pool of workers as they
+// become idle, so fn is called concurrently. Every File of a path is closed as soon as fn
+// has returned for all of them and must not be retained.
+// Scan returns a result for every path in paths order; errors from fn are recorded there.
+func Scan(paths []string, opts ScanOptions, fn func(path string, f *File) error) ([]ScanResult, error) {
+	if opts.Workers <= 0 {
+		opts.Workers = runtime.NumCPU()
+	}
+	if opts.MaxOpenFiles <= 0 {
+		opts.MaxOpenFiles = opts.Workers
+	}
+	if opts.Workers > opts.MaxOpenFiles {
+		opts.Workers = opts.MaxOpenFiles
+	}
+	if opts.Workers > len(paths) {
+		opts.Workers = len(paths)
+	}
+	if opts.MaxMemory < 0 {
+		return nil, fmt.Errorf("invalid ScanOptions.MaxMemory %d", opts.MaxMemory)
+	}
+
+	s := &scanner{
+		opts: opts,
+		fn:   fn,
+		mem:  newMemBudget(opts.MaxMemory),
+	}
+
+	results := make([]ScanResult, len(paths))
+	var next int64 = -1
+	var wg sync.WaitGroup
+	for w := 0; w < opts.Workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				i := int(atomic.AddInt64(&next, 1))
+				if i >= len(paths) {
+					return
+				}
+				results[i] = s.scan(paths[i])
+			}
+		}()
+	}
+	wg.Wait()
+
+	return results, nil
+}
+
+// scan opens, parses and visits a single path
+func (s *scanner) scan(path string) (res ScanResult) {
+	res.Path = path
+	start := time.Now()
+	defer func() {
+		res.Total = time.Since(start)
+	}()
+
+	f, err := os.Open(path)
+	if err != nil {
+		res.Err = err
+		return res
+	}
+	defer f.Close()
+
+	fi, err := f.Stat()
+	if err != nil {
+		res.Err = err
+		return res
+	}
+	res.Size = fi.Size()
+
+	kind, err := sniffMagic(f)
+	if err != nil {
+		res.Err = fmt.Errorf("failed to read magic: %v", err)
+		return res
+	}
+	if kind == scanSkip {
+		res.Skipped = true
+		return res
+	}
+	res.Fat = kind == scanFat
+
+	defer s.mem.release(s.mem.acquire(res.Size))
+
+	var r io.ReaderAt = f
+	if s.opts.Mmap {
+		dat, err := mmap(f)
+		if err != nil {
+			res.Err = fmt.Errorf("failed to mmap %s: %v", path, err)
+			return res
+		}
+		mr := newMmapReader(dat)
+		defer mr.Close()
+		r = mr
+	}
+
+	parseStart := time.Now()
+	if !res.Fat {
+		m, err := NewFile(r, s.opts.FileConfig)
+		res.Parse = time.Since(parseStart)
+		if err != nil {
+			res.Err = err
+			return res
+		}
+		res.Files = 1
+		res.Err = s.fn(path, m)
+		return res
+	}
+
+	ff, err := NewFatFile(r, FatFileConfig{LazyArches: true, FileConfig: s.opts.FileConfig})
+	res.Parse = time.Since(parseStart)
+	if err != nil {
+		res.Err = err
+		return res
+	}
+	// parse each architecture right before fn needs it
+	for i := range ff.Arches {
+		parseStart = time.Now()
+		m, err := ff.Arches[i].Open()
+		res.Parse += time.Since(parseStart)
+		if err != nil {
+			res.Err = err
+			return res
+		}
+		res.Files++
+		if err := s.fn(path, m); err != nil {
+			res.Err = err
+			return res
+		}
+	}
+	return res
+}
@@ -37,10 +37,8 @@ func (f *File) GetSwiftProtocols() (*[]protocols.Protocol, error) {
 		for idx, relOff := range relOffsets {
 			offset := int64(sec.Offset+uint32(idx*sizeOfInt32)) + int64(relOff)
 
-			f.sr.Seek(offset, io.SeekStart)
-
 			var proto protocols.Protocol
-			if err := binary.Read(f.sr, f.ByteOrder, &proto.Descriptor); err != nil {
+			if err := binary.Read(f.newReader(offset), f.ByteOrder, &proto.Descriptor); err != nil {
 				return nil, fmt.Errorf("failed to read protocols.Descriptor: %v", err)
 			}
 
@@ -50,10 +48,8 @@ func (f *File) GetSwiftProtocols() (*[]protocols.Protocol, error) {
 			}
 
 			parentOffset := offset + 4 + int64(proto.Descriptor.Parent)
-			f.sr.Seek(parentOffset, io.SeekStart)
-
 			proto.Parent = new(protocols.Protocol)
-			if err := binary.Read(f.sr, f.ByteOrder, &proto.Parent.Descriptor); err != nil {
+			if err := binary.Read(f.newReader(parentOffset), f.ByteOrder, &proto.Parent.Descriptor); err != nil {
 				return nil, fmt.Errorf("failed to read protocols.Descriptor: %v", err)
 			}
 
@@ -89,10 +85,8 @@ func (f *File) GetSwiftProtocolConformances() (*[]protocols.ConformanceDescripto
 		for idx, relOff := range relOffsets {
 			offset := int64(sec.Offset+uint32(idx*sizeOfInt32)) + int64(relOff)
 
-			f.sr.Seek(offset, io.SeekStart)
-
 			var pcd protocols.ConformanceDescriptor
-			if err := binary.Read(f.sr, f.ByteOrder, &pcd); err != nil {
+			if err := binary.Read(f.newReader(offset), f.ByteOrder, &pcd); err != nil {
 				return nil, fmt.Errorf("failed to read swift.ProtocolDescriptor: %v", err)
 			}
 
@@ -122,10 +116,10 @@ func (f *File) GetSwiftTypes() (*[]stypes.TypeDescriptor, error) {
 		for idx, relOff := range relOffsets {
 			offset := int64(sec.Offset+uint32(idx*sizeOfInt32)) + int64(relOff)
 
-			f.sr.Seek(offset, io.SeekStart)
+			r := f.newReader(offset)
 
 			var tDesc stypes.TypeDescriptor
-			if err := binary.Read(f.sr, f.ByteOrder, &tDesc); err != nil {
+			if err := binary.Read(r, f.ByteOrder, &tDesc); err != nil {
 				return nil, fmt.Errorf("failed to read stypes.TypeDescriptor: %v", err)
 			}
 
@@ -134,10 +128,10 @@ func (f *File) GetSwiftTypes() (*[]stypes.TypeDescriptor, error) {
 			if tDesc.Flags.Kind() == stypes.Struct {
 				var sD stypes.StructDescriptor
 				sD.TypeDescriptor = tDesc
-				if err := binary.Read(f.sr, f.ByteOrder, &sD.NumFields); err != nil {
+				if err := binary.Read(r, f.ByteOrder, &sD.NumFields); err != nil {
 					return nil, fmt.Errorf("failed to read types.StructDescriptor: %v", err)
 				}
-				if err := binary.Read(f.sr, f.ByteOrder, &sD.FieldOffsetVectorOffset); err != nil {
+				if err := binary.Read(r, f.ByteOrder, &sD.FieldOffsetVectorOffset); err != nil {
 					return nil, fmt.Errorf("failed to read types.StructDescriptor: %v", err)
 				}
 				fmt.Printf("%#v\n", sD)
@@ -172,12 +166,9 @@ func (f *File) readField(offset int64) (*fieldmd.Field, error) {
 	var field fieldmd.Field
 	var err error
 
-	currOffset, err := f.sr.Seek(offset, io.SeekStart)
-	if err != nil {
-		return nil, err
-	}
+	currOffset := offset
 
-	if err := binary.Read(f.sr, f.ByteOrder, &field.Descriptor.Header); err != nil {
+	if err := binary.Read(f.newReader(offset), f.ByteOrder, &field.Descriptor.Header); err != nil {
 		return nil, fmt.Errorf("failed to read swift.Header: %v", err)
 	}
 
@@ -197,13 +188,10 @@ func (f *File) readField(offset int64) (*fieldmd.Field, error) {
 		}
 	}
 
-	currOffset, err = f.sr.Seek(offset+int64(binary.Size(fieldmd.Header{})), io.SeekStart)
-	if err != nil {
-		return nil, err
-	}
+	currOffset = offset + int64(binary.Size(fieldmd.Header{}))
 
 	field.Descriptor.FieldRecords = make([]fieldmd.RecordT, field.Descriptor.Header.NumFields)
-	if err := binary.Read(f.sr, f.ByteOrder, &field.Descriptor.FieldRecords); err != nil {
+	if err := binary.Read(f.newReader(currOffset), f.ByteOrder, &field.Descriptor.FieldRecords); err != nil {
 		return nil, fmt.Errorf("failed to read []fieldmd.RecordT: %v", err)
 	}
 
@@ -412,34 +400,33 @@ func (f *File) GetSwiftClosures() (*[]swift.CaptureDescriptor, error) {
 // GetMangledTypeAtOffset reads a mangled type at a given offset in the MachO
 func (f *File) GetMangledTypeAtOffset(offset int64) (string, *stypes.TypeDescriptor, error) {
 
-	if _, err := f.sr.Seek(offset, io.SeekStart); err != nil {
-		return "", nil, fmt.Errorf("failed to Seek: %v", err)
+	if offset < 0 {
+		return "", nil, fmt.Errorf("invalid mangled type offset 0x%x", offset)
 	}
+	r := f.newReader(offset)
 
 	var refType byte
-	if err := binary.Read(f.sr, f.ByteOrder, &refType); err != nil {
+	if err := binary.Read(r, f.ByteOrder, &refType); err != nil {
 		return "", nil, fmt.Errorf("failed to read possible symbolic reference type at offset 0x%x, %v", offset, err)
 	}
 
 	if refType >= byte(0x01) && refType <= byte(0x17) {
 
 		var t32 int32
-		if err := binary.Read(f.sr, f.ByteOrder, &t32); err != nil {
+		if err := binary.Read(r, f.ByteOrder, &t32); err != nil {
 			return "", nil, fmt.Errorf("failed to read 32bit symbolic ref: %v", err)
 		}
 
 		switch refType {
 		case 1:
 			typeDescOffset := offset + int64(t32) + 1
-			f.sr.Seek(typeDescOffset, io.SeekStart)
 			var tDesc stypes.TypeDescriptor
-			if err := binary.Read(f.sr, f.ByteOrder, &tDesc); err != nil {
+			if err := binary.Read(f.newReader(typeDescOffset), f.ByteOrder, &tDesc); err != nil {
 				return "", nil, fmt.Errorf("failed to read stypes.TypeDescriptor: %v", err)
 			}
 			parentDescOffset := typeDescOffset + sizeOfInt32 + int64(tDesc.Parent)
-			f.sr.Seek(parentDescOffset, io.SeekStart)
 			var parentDesc stypes.TypeDescriptor
-			if err := binary.Read(f.sr, f.ByteOrder, &parentDesc); err != nil {
+			if err := binary.Read(f.newReader(parentDescOffset), f.ByteOrder, &parentDesc); err != nil {
 				return "", nil, fmt.Errorf("failed to read stypes.TypeDescriptor: %v", err)
 			}
 			fmt.Println("parent:", parentDesc)
@@ -457,9 +444,8 @@ func (f *File) GetMangledTypeAtOffset(offset int64) (string, *stypes.TypeDescrip
 			fmt.Println("name:", parent, name, tDesc.Flags)
 			return parent + "." + name, &tDesc, nil
 		case 2:
-			f.sr.Seek(offset+int64(t32)+1, io.SeekStart)
 			var context uint64
-			if err := binary.Read(f.sr, f.ByteOrder, &context); err != nil {
+			if err := binary.Read(f.newReader(offset+int64(t32)+1), f.ByteOrder, &context); err != nil {
 				return "", nil, fmt.Errorf("failed to read 32bit symbolic ref: %v", err)
 			}
 			// Check if context pointer is a dyld chain fixup REBASE
@@ -468,10 +454,8 @@ func (f *File) GetMangledTypeAtOffset(offset int64) (string, *stypes.TypeDescrip
 				if err != nil {
 					return "", nil, fmt.Errorf("failed to GetOffset: %v", err)
 				}
-				f.sr.Seek(int64(off), io.SeekStart)
-
 				var tDesc stypes.TypeDescriptor
-				if err := binary.Read(f.sr, f.ByteOrder, &tDesc); err != nil {
+				if err := binary.Read(f.newReader(int64(off)), f.ByteOrder, &tDesc); err != nil {
 					return "", nil, fmt.Errorf("failed to read stypes.TypeDescriptor: %v", err)
 				}
 
@@ -495,15 +479,15 @@ func (f *File) GetMangledTypeAtOffset(offset int64) (string, *stypes.TypeDescrip
 
 	} else if refType >= byte(0x18) && refType <= byte(0x1F) { // TODO: finish support for these types
 		int64Bytes := make([]byte, 8)
-		if _, err := f.sr.Read(int64Bytes); err != nil {
+		if _, err := r.Read(int64Bytes); err != nil {
 			return "", nil, fmt.Errorf("unsupported symbolic REF: %X, 0x%x", refType, offset+int64(binary.LittleEndian.Uint64(int64Bytes)))
 		}
 	} else { // regular string mangled type
 		// revert the peek byte read
-		if _, err := f.sr.Seek(-1, io.SeekCurrent); err != nil {
+		if _, err := r.Seek(0, io.SeekStart); err != nil {
 			return "", nil, fmt.Errorf("failed to Seek: %v", err)
 		}
-		s, err := bufio.NewReader(f.sr).ReadString('\x00')
+		s, err := bufio.NewReader(r).ReadString('\x00')
 		if err != nil {
 			return "", nil, fmt.Errorf("failed to ReadBytes at offset 0x%x, %v", offset, err)
 		}
@@ -0,0 +1,133 @@
+package macho
+
+import (
+	"fmt"
+	"sort"
+	"strings"
+)
+
+// SymbolIndex is a lookup index over a File's Symtab built by File.IndexSymbols.
+// Name lookups are hash lookups and address lookups are binary searches.
+type SymbolIndex struct {
+	syms    []Symbol
+	byName  map[string]int32 // exact name -> first symbol index
+	byFold  map[string]int32 // case folded name -> first symbol index
+	byAddr  []int32          // all symbols ordered by address (stable)
+	defined []int32          // non-debug symbols defined in a section ordered by address
+}
+
+// foldName maps name to a key shared by every string strings.EqualFold considers equal to it
+func foldName(name string) string {
+	return strings.ToLower(strings.ToUpper(name))
+}
+
+func newSymbolIndex(syms []Symbol) *SymbolIndex {
+	idx := &SymbolIndex{
+		syms:   syms,
+		byName: make(map[string]int32, len(syms)),
+		byFold: make(map[string]int32, len(syms)),
+		byAddr: make([]int32, len(syms)),
+	}
+	for i, sym := range syms {
+		if _, ok := idx.byName[sym.Name]; !ok {
+			idx.byName[sym.Name] = int32(i)
+		}
+		key := foldName(sym.Name)
+		if _, ok := idx.byFold[key]; !ok {
+			idx.byFold[key] = int32(i)
+		}
+		idx.byAddr[i] = int32(i)
+		if !sym.Type.IsDebugSym() && sym.Type.IsDefinedInSection() {
+			idx.defined = append(idx.defined, int32(i))
+		}
+	}
+	sort.SliceStable(idx.byAddr, func(i, j int) bool {
+		return syms[idx.byAddr[i]].Value < syms[idx.byAddr[j]].Value
+	})
+	sort.SliceStable(idx.defined, func(i, j int) bool {
+		return syms[idx.defined[i]].Value < syms[idx.defined[j]].Value
+	})
+	return idx
+}
+
+// Lookup returns the first symbol named name
+func (idx *SymbolIndex) Lookup(name string) (Symbol, bool) {
+	if i, ok := idx.byName[name]; ok {
+		return idx.syms[i], true
+	}
+	return Symbol{}, false
+}
+
+// LookupFold returns the first symbol whose name matches name under strings.EqualFold
+func (idx *SymbolIndex) LookupFold(name string) (Symbol, bool) {
+	if i, ok := idx.byFold[foldName(name)]; ok {
+		return idx.syms[i], true
+	}
+	return Symbol{}, false
+}
+
+// searchAddr returns the position of the first entry in order whose value is >= addr
+func (idx *SymbolIndex) searchAddr(order []int32, addr uint64) int {
+	return sort.Search(len(order), func(i int) bool {
+		return idx.syms[order[i]].Value >= addr
+	})
+}
+
+// AtAddr returns every symbol whose value is addr, in symbol table order
+func (idx *SymbolIndex) AtAddr(addr uint64) []Symbol {
+	var syms []Symbol
+	for i := idx.searchAddr(idx.byAddr, addr); i < len(idx.byAddr) && idx.syms[idx.byAddr[i]].Value == addr; i++ {
+		syms = append(syms, idx.syms[idx.byAddr[i]])
+	}
+	return syms
+}
+
+// Nearest returns the closest defined symbol at or below addr and the offset of addr from it.
+// Debug (stab), undefined and absolute symbols are not considered.
+func (idx *SymbolIndex) Nearest(addr uint64) (Symbol, uint64, bool) {
+	i := idx.searchAddr(idx.defined, addr)
+	if i < len(idx.defined) && idx.syms[idx.defined[i]].Value == addr {
+		return idx.syms[idx.defined[i]], 0, true
+	}
+	if i == 0 {
+		return Symbol{}, 0, false
+	}
+	sym := idx.syms[idx.defined[i-1]]
+	return sym, addr - sym.Value, true
+}
+
+// IndexSymbols builds (once) and returns the symbol lookup index for f.
+// Once built, FindSymbolAddress and FindAddressSymbols use it instead of scanning the symtab.
+func (f *File) IndexSymbols() (*SymbolIndex, error) {
+	if f.Symtab == nil {
+		return nil, fmt.Errorf("macho does not contain a symtab")
+	}
+	if err := f.ParseSymtab(); err != nil {
+		return nil, err
+	}
+	f.lazy.Lock()
+	defer f.lazy.Unlock()
+	if f.symidx == nil {
+		f.symidx = newSymbolIndex(f.Symtab.Syms)
+	}
+	return f.symidx, nil
+}
+
+// symbolIndex returns the symbol index if IndexSymbols has been called
+func (f *File) symbolIndex() *SymbolIndex {
+	f.lazy.Lock()
+	defer f.lazy.Unlock()
+	return f.symidx
+}
+
+// FindNearestSymbol returns the closest symbol at or below addr and the offset of addr from it (i.e. symbol+offset)
+func (f *File) FindNearestSymbol(addr uint64) (Symbol, uint64, error) {
+	idx, err := f.IndexSymbols()
+	if err != nil {
+		return Symbol{}, 0, err
+	}
+	if sym, off, ok := idx.Nearest(addr); ok {
+		return sym, off, nil
+	}
+	return Symbol{}, 0, fmt.Errorf("no symbol found at or below addr %#016x", addr)
+}
@@ -143,6 +143,28 @@ type Segment32 struct {
 	Flag    SegFlag      /* flags */
 }
 
+const (
+	Segment32Size = 56
+	Segment64Size = 72
+)
+
+// Get decodes a 32-bit segment load command from b
+func (s *Segment32) Get(b []byte, o binary.ByteOrder) int {
+	_ = b[Segment32Size-1] // bounds check hint to compiler
+	s.LoadCmd = LoadCmd(o.Uint32(b[0:]))
+	s.Len = o.Uint32(b[4:])
+	copy(s.Name[:], b[8:24])
+	s.Addr = o.Uint32(b[24:])
+	s.Memsz = o.Uint32(b[28:])
+	s.Offset = o.Uint32(b[32:])
+	s.Filesz = o.Uint32(b[36:])
+	s.Maxprot = VmProtection(o.Uint32(b[40:]))
+	s.Prot = VmProtection(o.Uint32(b[44:]))
+	s.Nsect = o.Uint32(b[48:])
+	s.Flag = SegFlag(o.Uint32(b[52:]))
+	return Segment32Size
+}
+
 // A SymtabCmd is a Mach-O symbol table command.
 type SymtabCmd struct {
 	LoadCmd // LC_SYMTAB
@@ -342,6 +364,23 @@ type Segment64 struct {
 	Flag    SegFlag      /* flags */
 }
 
+// Get decodes a 64-bit segment load command from b
+func (s *Segment64) Get(b []byte, o binary.ByteOrder) int {
+	_ = b[Segment64Size-1] // bounds check hint to compiler
+	s.LoadCmd = LoadCmd(o.Uint32(b[0:]))
+	s.Len = o.Uint32(b[4:])
+	copy(s.Name[:], b[8:24])
+	s.Addr = o.Uint64(b[24:])
+	s.Memsz = o.Uint64(b[32:])
+	s.Offset = o.Uint64(b[40:])
+	s.Filesz = o.Uint64(b[48:])
+	s.Maxprot = VmProtection(o.Uint32(b[56:]))
+	s.Prot = VmProtection(o.Uint32(b[60:]))
+	s.Nsect = o.Uint32(b[64:])
+	s.Flag = SegFlag(o.Uint32(b[68:]))
+	return Segment64Size
+}
+
 // A Routines64Cmd is a Mach-O 64-bit image routines command.
 type Routines64Cmd struct {
 	LoadCmd     // LC_ROUTINES_64
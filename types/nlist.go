@@ -29,6 +29,17 @@ func (n *Nlist32) Put32(b []byte, o binary.ByteOrder) uint32 {
 	return 8 + 4
 }
 
+// Get32 decodes a 32-bit symbol table entry from b, the inverse of Put32
+func (n *Nlist32) Get32(b []byte, o binary.ByteOrder) uint32 {
+	_ = b[11] // bounds check hint to compiler
+	n.Name = o.Uint32(b[0:])
+	n.Type = NType(b[4])
+	n.Sect = b[5]
+	n.Desc = NDescType(o.Uint16(b[6:]))
+	n.Value = o.Uint32(b[8:])
+	return 8 + 4
+}
+
 // An Nlist64 is a Mach-O 64-bit symbol table entry.
 type Nlist64 struct {
 	Nlist
@@ -44,6 +55,17 @@ func (n *Nlist64) Put64(b []byte, o binary.ByteOrder) uint32 {
 	return 8 + 8
 }
 
+// Get64 decodes a 64-bit symbol table entry from b, the inverse of Put64
+func (n *Nlist64) Get64(b []byte, o binary.ByteOrder) uint32 {
+	_ = b[15] // bounds check hint to compiler
+	n.Name = o.Uint32(b[0:])
+	n.Type = NType(b[4])
+	n.Sect = b[5]
+	n.Desc = NDescType(o.Uint16(b[6:]))
+	n.Value = o.Uint64(b[8:])
+	return 8 + 8
+}
+
 type NType uint8
 
 /*
@@ -1,6 +1,8 @@
 package objc
 
 import (
+	"bytes"
+	"encoding/binary"
 	"fmt"
 	"strings"
 
@@ -178,18 +180,41 @@ func (ml MethodList) String() string {
 	return fmt.Sprintf("entrysize=0x%08x, fixed_up=%t, uniqued=%t, small=%t", ml.EntSize(), ml.FixedUp(), ml.IsUniqued(), ml.IsSmall())
 }
 
+const (
+	MethodTSize      = 24
+	MethodSmallTSize = 12
+)
+
 type MethodT struct {
 	NameVMAddr  uint64 // SEL
 	TypesVMAddr uint64 // const char *
 	ImpVMAddr   uint64 // IMP
 }
 
+// Get decodes a method_t from b
+func (m *MethodT) Get(b []byte, o binary.ByteOrder) int {
+	_ = b[MethodTSize-1] // bounds check hint to compiler
+	m.NameVMAddr = o.Uint64(b[0:])
+	m.TypesVMAddr = o.Uint64(b[8:])
+	m.ImpVMAddr = o.Uint64(b[16:])
+	return MethodTSize
+}
+
 type MethodSmallT struct {
 	NameOffset  int32 // SEL
 	TypesOffset int32 // const char *
 	ImpOffset   int32 // IMP
 }
 
+// Get decodes a relative method_t from b
+func (m *MethodSmallT) Get(b []byte, o binary.ByteOrder) int {
+	_ = b[MethodSmallTSize-1] // bounds check hint to compiler
+	m.NameOffset = int32(o.Uint32(b[0:]))
+	m.TypesOffset = int32(o.Uint32(b[4:]))
+	m.ImpOffset = int32(o.Uint32(b[8:]))
+	return MethodSmallTSize
+}
+
 type Method struct {
 	NameVMAddr  uint64 // & SEL
 	TypesVMAddr uint64 // & const char *
@@ -203,27 +228,91 @@ type Method struct {
 	Pointer            types.FilePointer
 }
 
+// Encoding returns the decoded method type encoding (shared by every method with the same Types)
+func (m *Method) Encoding() (*MethodEncoding, error) {
+	return DecodeMethodEncoding(m.Types)
+}
+
 // NumberOfArguments returns the number of method arguments
 func (m *Method) NumberOfArguments() int {
 	if m == nil {
 		return 0
 	}
+	if enc, err := m.Encoding(); err == nil {
+		return len(enc.Args)
+	}
 	return getNumberOfArguments(m.Types)
 }
 
 // ReturnType returns the method's return type
 func (m *Method) ReturnType() string {
+	if enc, err := m.Encoding(); err == nil {
+		return enc.Return.String()
+	}
 	return getReturnType(m.Types)
 }
 
+// ArgumentType returns the type at index in the method's type list: the return type at index 0
+// followed by the arguments (self, _cmd, ...)
 func (m *Method) ArgumentType(index int) string {
+	if enc, err := m.Encoding(); err == nil {
+		if index == 0 {
+			return enc.Return.String()
+		}
+		if 0 < index && index <= len(enc.Args) {
+			return enc.Args[index-1].Type.String()
+		}
+		return "<error>"
+	}
 	args := getArguments(m.Types)
-	if 0 < len(args) && index <= len(args) {
+	if 0 <= index && index < len(args) {
 		return args[index].DecType
 	}
 	return "<error>"
 }
 
+// MethodTable is a columnar view of method lists: method i is named Strings[NameOffsets[i]:] and has the
+// type encoding Strings[TypeOffsets[i]:] (both NUL terminated) and the implementation Imps[i].
+// Each distinct string is stored once in Strings.
+type MethodTable struct {
+	Lists       []uint32 // Lists[j] is the index of the first method of the j-th method list
+	NameOffsets []uint32
+	TypeOffsets []uint32
+	Imps        []uint64
+	Strings     []byte
+}
+
+// Len returns the number of methods in the table
+func (t *MethodTable) Len() int {
+	return len(t.Imps)
+}
+
+// CString returns the NUL terminated string at off in the string table
+func (t *MethodTable) CString(off uint32) string {
+	s := t.Strings[off:]
+	return string(s[:bytes.IndexByte(s, 0)])
+}
+
+// Name returns the selector of method i
+func (t *MethodTable) Name(i int) string {
+	return t.CString(t.NameOffsets[i])
+}
+
+// Types returns the type encoding of method i
+func (t *MethodTable) Types(i int) string {
+	return t.CString(t.TypeOffsets[i])
+}
+
+// Method returns method i (only the name, types and IMP are set)
+func (t *MethodTable) Method(i int) Method {
+	return Method{
+		ImpVMAddr: t.Imps[i],
+		Name:      t.Name(i),
+		Types:     t.Types(i),
+		Pointer:   types.FilePointer{VMAdder: t.Imps[i]},
+	}
+}
+
 type PropertyList struct {
 	EntSize uint32
 	Count   uint32
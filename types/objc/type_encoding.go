@@ -5,6 +5,8 @@ import (
 	"fmt"
 	"regexp"
 	"strings"
+	"sync"
+	"sync/atomic"
 )
 
 var typeEncoding = map[string]string{
@@ -95,6 +97,25 @@ type varEncodedType struct {
 func decodeMethodTypes(encodedTypes string) (string, string) {
 	var argTypes []string
 
+	m, err := DecodeMethodEncoding(encodedTypes)
+	if err != nil {
+		return decodeMethodTypesLegacy(encodedTypes)
+	}
+	for _, arg := range m.Args {
+		argTypes = append(argTypes, arg.Type.String())
+	}
+	if len(argTypes) == 2 {
+		return m.Return.String(), ""
+	} else if len(argTypes) > 2 {
+		return m.Return.String(), fmt.Sprintf("(%s)", strings.Join(argTypes[2:], ", "))
+	}
+	return m.Return.String(), fmt.Sprintf("(%s)", strings.Join(argTypes, ", "))
+}
+
+// decodeMethodTypesLegacy is decodeMethodTypes for encodings DecodeMethodEncoding rejects
+func decodeMethodTypesLegacy(encodedTypes string) (string, string) {
+	var argTypes []string
+
 	// skip return type
 	encArgs := strings.TrimLeft(skipFirstType(encodedTypes), "0123456789")
 
@@ -335,3 +356,331 @@ func getArguments(encArgs string) []methodEncodedArg {
 	}
 	return args
 }
+
+// TypeKind is the kind of a decoded type encoding node
+type TypeKind uint8
+
+const (
+	TypeBasic     TypeKind = iota // a single character type such as i, d, @ or #
+	TypePointer                   // ^T
+	TypeFuncPtr                   // ^? (function pointer)
+	TypeObject                    // @"Class" or @"<Protocol>"
+	TypeBlock                     // @? (optionally followed by an extended <signature>)
+	TypeArray                     // [NT]
+	TypeStruct                    // {Name=T...}
+	TypeUnion                     // (Name=T...)
+	TypeBitField                  // bN
+	TypeQualified                 // a type specifier (const, in, out, ...) applied to Elem
+)
+
+// Type is a node of a decoded type encoding
+type Type struct {
+	Kind   TypeKind
+	Enc    string  // the encoding of the node
+	Name   string  // the basic type or specifier character, the object class or the struct/union tag
+	Size   int     // the array length or bit field width
+	Elem   *Type   // the pointee, array element or qualified type
+	Fields []Field // the struct or union members
+}
+
+// Field is a struct or union member; Name is empty unless the encoding includes the member names
+type Field struct {
+	Name string
+	Type *Type
+}
+
+// String returns the C declaration of t
+func (t *Type) String() string {
+	switch t.Kind {
+	case TypePointer:
+		return t.Elem.String() + " *"
+	case TypeFuncPtr:
+		return typeEncoding["^?"]
+	case TypeObject:
+		return t.Name
+	case TypeArray:
+		return fmt.Sprintf("[%d]%s", t.Size, t.Elem)
+	case TypeStruct:
+		return "struct " + t.Name
+	case TypeUnion:
+		return "union " + t.Name
+	case TypeBitField:
+		return typeEncoding["b"]
+	case TypeQualified:
+		return typeSpecifiers[t.Name] + " " + t.Elem.String()
+	case TypeBlock:
+		return t.Enc
+	}
+	if typ, ok := typeEncoding[t.Name]; ok {
+		return typ
+	}
+	return t.Name
+}
+
+// MethodArg is a decoded method argument
+type MethodArg struct {
+	Type   *Type
+	Offset int // stack offset
+}
+
+// MethodEncoding is a decoded method type encoding: the return type, the stack frame size and
+// the arguments including self and _cmd
+type MethodEncoding struct {
+	Return    *Type
+	FrameSize int
+	Args      []MethodArg
+}
+
+// typeDecoder tokenizes a type encoding in a single left to right pass
+type typeDecoder struct {
+	s   string
+	pos int
+}
+
+func (d *typeDecoder) errorf(format string, args ...interface{}) error {
+	return fmt.Errorf("failed to decode type encoding %q at %d: %s", d.s, d.pos, fmt.Sprintf(format, args...))
+}
+
+func (d *typeDecoder) peek() byte {
+	if d.pos < len(d.s) {
+		return d.s[d.pos]
+	}
+	return 0
+}
+
+// number reads an optional decimal number
+func (d *typeDecoder) number() (int, bool) {
+	start := d.pos
+	n := 0
+	for d.pos < len(d.s) && '0' <= d.s[d.pos] && d.s[d.pos] <= '9' {
+		n = n*10 + int(d.s[d.pos]-'0')
+		d.pos++
+	}
+	return n, d.pos > start
+}
+
+// quoted reads a "..." string
+func (d *typeDecoder) quoted() (string, error) {
+	end := strings.IndexByte(d.s[d.pos+1:], '"')
+	if end < 0 {
+		return "", d.errorf("unterminated string")
+	}
+	s := d.s[d.pos+1 : d.pos+1+end]
+	d.pos += end + 2
+	return s, nil
+}
+
+// typ decodes the type at the current position; inStruct is set for the members of a
+// struct or union with named members, where a quote after @ may start the next name
+func (d *typeDecoder) typ(inStruct bool) (*Type, error) {
+	start := d.pos
+	if d.pos >= len(d.s) {
+		return nil, d.errorf("missing type")
+	}
+	t := &Type{Name: d.s[d.pos : d.pos+1]}
+	c := d.s[d.pos]
+	d.pos++
+
+	var err error
+	switch c {
+	case 'r', 'n', 'N', 'o', 'O', 'R', 'V', 'A', 'j', '!':
+		t.Kind = TypeQualified
+		t.Elem, err = d.typ(inStruct)
+	case '^':
+		if d.peek() == '?' {
+			d.pos++
+			t.Kind = TypeFuncPtr
+			break
+		}
+		t.Kind = TypePointer
+		t.Elem, err = d.typ(inStruct)
+	case '@':
+		switch d.peek() {
+		case '?':
+			d.pos++
+			t.Kind = TypeBlock
+			if d.peek() == '<' { // extended block signature
+				err = d.skipBalanced('<', '>')
+			}
+		case '"':
+			save := d.pos
+			var name string
+			if name, err = d.quoted(); err != nil {
+				break
+			}
+			// inside a struct @"x" is only a class name if the next member name or the end follows
+			if inStruct && d.peek() != '"' && d.peek() != '}' && d.peek() != ')' {
+				d.pos = save
+				break
+			}
+			t.Kind = TypeObject
+			t.Name = name
+		}
+	case '[':
+		t.Kind = TypeArray
+		t.Size, _ = d.number()
+		if t.Elem, err = d.typ(false); err != nil {
+			break
+		}
+		if d.peek() != ']' {
+			err = d.errorf("expected ]")
+			break
+		}
+		d.pos++
+	case '{', '(':
+		t.Kind, t.Name, t.Fields, err = d.aggregate(c)
+	case 'b':
+		t.Kind = TypeBitField
+		t.Size, _ = d.number()
+	case 'c', 'C', 's', 'S', 'i', 'I', 'l', 'L', 'q', 'Q', 't', 'T', 'f', 'd', 'D', 'B', 'v', 'z', 'Z', 'w', '?', '*', '#', ':', '%':
+	default:
+		d.pos--
+		return nil, d.errorf("unknown type %q", c)
+	}
+	if err != nil {
+		return nil, err
+	}
+	t.Enc = d.s[start:d.pos]
+	return t, nil
+}
+
+// aggregate decodes the struct or union whose opening bracket open was just read
+func (d *typeDecoder) aggregate(open byte) (TypeKind, string, []Field, error) {
+	kind, close := TypeStruct, byte('}')
+	if open == '(' {
+		kind, close = TypeUnion, ')'
+	}
+
+	// the tag runs up to '=' or the closing bracket
+	start := d.pos
+	for d.pos < len(d.s) && d.s[d.pos] != '=' && d.s[d.pos] != close {
+		d.pos++
+	}
+	if d.pos >= len(d.s) {
+		return kind, "", nil, d.errorf("unterminated %c", open)
+	}
+	name := d.s[start:d.pos]
+	if d.s[d.pos] == close {
+		d.pos++
+		return kind, name, nil, nil
+	}
+	d.pos++ // '='
+
+	var fields []Field
+	named := d.peek() == '"'
+	for d.peek() != close {
+		if d.pos >= len(d.s) {
+			return kind, "", nil, d.errorf("unterminated %c", open)
+		}
+		var f Field
+		if named {
+			if d.peek() != '"' {
+				return kind, "", nil, d.errorf("expected member name")
+			}
+			var err error
+			if f.Name, err = d.quoted(); err != nil {
+				return kind, "", nil, err
+			}
+		}
+		typ, err := d.typ(named)
+		if err != nil {
+			return kind, "", nil, err
+		}
+		f.Type = typ
+		fields = append(fields, f)
+	}
+	d.pos++
+	return kind, name, fields, nil
+}
+
+// skipBalanced skips from the open bracket at the current position past its matching close
+func (d *typeDecoder) skipBalanced(open, close byte) error {
+	depth := 0
+	for ; d.pos < len(d.s); d.pos++ {
+		switch d.s[d.pos] {
+		case open:
+			depth++
+		case close:
+			depth--
+			if depth == 0 {
+				d.pos++
+				return nil
+			}
+		}
+	}
+	return d.errorf("unterminated %c", open)
+}
+
+// DecodeTypeEncoding decodes a single type encoding such as an ivar type
+func DecodeTypeEncoding(enc string) (*Type, error) {
+	d := typeDecoder{s: enc}
+	t, err := d.typ(false)
+	if err != nil {
+		return nil, err
+	}
+	if d.pos != len(enc) {
+		return nil, d.errorf("trailing data")
+	}
+	return t, nil
+}
+
+// decodeMethodEncoding decodes a method type encoding: the return type, the frame size and each
+// argument type followed by its (possibly negative or register hinted) offset
+func decodeMethodEncoding(enc string) (*MethodEncoding, error) {
+	d := typeDecoder{s: enc}
+	ret, err := d.typ(false)
+	if err != nil {
+		return nil, err
+	}
+	m := &MethodEncoding{Return: ret}
+	m.FrameSize, _ = d.number()
+	for d.pos < len(d.s) {
+		var arg MethodArg
+		if arg.Type, err = d.typ(false); err != nil {
+			return nil, err
+		}
+		if d.peek() == '+' { // GNU register hint
+			d.pos++
+		}
+		neg := d.peek() == '-'
+		if neg {
+			d.pos++
+		}
+		arg.Offset, _ = d.number()
+		if neg {
+			arg.Offset = -arg.Offset
+		}
+		m.Args = append(m.Args, arg)
+	}
+	return m, nil
+}
+
+// methodEncodings interns the decoded method type encodings of the process; binaries reuse
+// a few thousand encodings across all of their methods. Only successful decodes are stored and
+// the cache stops growing at maxMethodEncodings entries, so a long running scanner fed many
+// distinct encodings keeps decoding them without holding on to every one.
+var (
+	methodEncodings    sync.Map // string -> *MethodEncoding
+	numMethodEncodings int64    // entries in methodEncodings (atomic)
+	maxMethodEncodings int64    = 1 << 16
+)
+
+// DecodeMethodEncoding decodes a method type encoding. Distinct valid encodings are decoded once
+// per process (up to the cache limit) and the result is shared, so it must not be modified.
+func DecodeMethodEncoding(enc string) (*MethodEncoding, error) {
+	if m, ok := methodEncodings.Load(enc); ok {
+		return m.(*MethodEncoding), nil
+	}
+	m, err := decodeMethodEncoding(enc)
+	if err != nil {
+		return nil, err
+	}
+	if atomic.LoadInt64(&numMethodEncodings) >= maxMethodEncodings {
+		return m, nil
+	}
+	actual, loaded := methodEncodings.LoadOrStore(enc, m)
+	if !loaded {
+		atomic.AddInt64(&numMethodEncodings, 1)
+	}
+	return actual.(*MethodEncoding), nil
+}
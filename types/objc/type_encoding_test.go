@@ -0,0 +1,128 @@
+package objc
+
+import (
+	"fmt"
+	"testing"
+)
+
+func TestDecodeTypeEncoding(t *testing.T) {
+	tests := []struct {
+		enc  string
+		kind TypeKind
+		want string
+	}{
+		{"i", TypeBasic, "int"},
+		{"@", TypeBasic, "id"},
+		{"*", TypeBasic, "char *"},
+		{"r*", TypeQualified, "const char *"},
+		{"^v", TypePointer, "void *"},
+		{"^?", TypeFuncPtr, "IMP"},
+		{"@?", TypeBlock, "@?"},
+		{"@?<v@?@>", TypeBlock, "@?<v@?@>"},
+		{`@"NSString"`, TypeObject, "NSString"},
+		{"[16C]", TypeArray, "[16]unsigned char"},
+		{"{CGRect={CGPoint=dd}{CGSize=dd}}", TypeStruct, "struct CGRect"},
+		{`{_NSRange="location"Q"length"Q}`, TypeStruct, "struct _NSRange"},
+		{"^{__CFString}", TypePointer, "struct __CFString *"},
+		{"(?=i^v)", TypeUnion, "union ?"},
+		{"b4", TypeBitField, "bit field"},
+	}
+	for _, tt := range tests {
+		typ, err := DecodeTypeEncoding(tt.enc)
+		if err != nil {
+			t.Errorf("DecodeTypeEncoding(%q): %v", tt.enc, err)
+			continue
+		}
+		if typ.Kind != tt.kind || typ.String() != tt.want || typ.Enc != tt.enc {
+			t.Errorf("DecodeTypeEncoding(%q) = kind %d %q (enc %q); want kind %d %q", tt.enc, typ.Kind, typ, typ.Enc, tt.kind, tt.want)
+		}
+	}
+
+	rect, _ := DecodeTypeEncoding("{CGRect={CGPoint=dd}{CGSize=dd}}")
+	if len(rect.Fields) != 2 || rect.Fields[1].Type.Name != "CGSize" || len(rect.Fields[1].Type.Fields) != 2 {
+		t.Errorf("CGRect decoded to %+v", rect.Fields)
+	}
+	// a quote after @ inside a struct with named members is a class name only if a member name or the end follows
+	obj, err := DecodeTypeEncoding(`{S="a"@"NSString""b"@"c"i}`)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if got := fmt.Sprintf("%s %s %s", obj.Fields[0].Type, obj.Fields[1].Type, obj.Fields[2].Name); got != "NSString id c" {
+		t.Errorf("named struct members decoded to %q", got)
+	}
+
+	for _, enc := range []string{"", "{A=i", "[4i", "@\"A", "X", "ii"} {
+		if _, err := DecodeTypeEncoding(enc); err == nil {
+			t.Errorf("DecodeTypeEncoding(%q) did not fail", enc)
+		}
+	}
+}
+
+func TestDecodeMethodEncoding(t *testing.T) {
+	enc := "{CGRect={CGPoint=dd}{CGSize=dd}}40@0:8^{CGContext=}16r*24@?<v@?>32"
+	m, err := DecodeMethodEncoding(enc)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if m.Return.String() != "struct CGRect" || m.FrameSize != 40 || len(m.Args) != 5 {
+		t.Fatalf("DecodeMethodEncoding(%q) = %s, %d, %d args", enc, m.Return, m.FrameSize, len(m.Args))
+	}
+	if m.Args[2].Type.String() != "struct CGContext *" || m.Args[3].Offset != 24 || m.Args[4].Type.Kind != TypeBlock {
+		t.Errorf("DecodeMethodEncoding(%q) decoded the arguments to %+v", enc, m.Args)
+	}
+	if again, _ := DecodeMethodEncoding(enc); again != m {
+		t.Error("DecodeMethodEncoding decoded the same encoding twice")
+	}
+	if _, err := DecodeMethodEncoding("v8@0:X"); err == nil {
+		t.Error("DecodeMethodEncoding(v8@0:X) did not fail")
+	}
+	if _, ok := methodEncodings.Load("v8@0:X"); ok {
+		t.Error("DecodeMethodEncoding cached a failed decode")
+	}
+
+	// past the cache limit encodings are still decoded but no longer stored
+	defer func(max int64) { maxMethodEncodings = max }(maxMethodEncodings)
+	maxMethodEncodings = numMethodEncodings
+	if m, err := DecodeMethodEncoding("v17@0:8"); err != nil || m.FrameSize != 17 {
+		t.Errorf("DecodeMethodEncoding(v17@0:8) past the cache limit = %+v, %v", m, err)
+	}
+	if _, ok := methodEncodings.Load("v17@0:8"); ok {
+		t.Error("DecodeMethodEncoding cached an encoding past the cache limit")
+	}
+	if again, _ := DecodeMethodEncoding(enc); again != m {
+		t.Error("DecodeMethodEncoding dropped a cached encoding at the cache limit")
+	}
+	if neg, err := decodeMethodEncoding("v8@-8:+4"); err != nil || neg.Args[0].Offset != -8 || neg.Args[1].Offset != 4 {
+		t.Errorf("decodeMethodEncoding(v8@-8:+4) = %+v, %v", neg, err)
+	}
+
+	meth := Method{Types: "B24@0:8@\"NSString\"16"}
+	if meth.ReturnType() != "BOOL" || meth.NumberOfArguments() != 3 {
+		t.Errorf("ReturnType = %s, NumberOfArguments = %d", meth.ReturnType(), meth.NumberOfArguments())
+	}
+	if got := []string{meth.ArgumentType(0), meth.ArgumentType(1), meth.ArgumentType(3), meth.ArgumentType(4)}; fmt.Sprint(got) != "[BOOL id NSString <error>]" {
+		t.Errorf("ArgumentType returned %q", got)
+	}
+	if rtype, args := decodeMethodTypes(meth.Types); rtype != "BOOL" || args != "(NSString)" {
+		t.Errorf("decodeMethodTypes(%q) = %q, %q", meth.Types, rtype, args)
+	}
+}
+
+func BenchmarkDecodeMethodEncoding(b *testing.B) {
+	const enc = "{CGRect={CGPoint=dd}{CGSize=dd}}40@0:8^{CGContext=}16r*24@?<v@?>32"
+	b.Run("decode", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			decodeMethodEncoding(enc)
+		}
+	})
+	b.Run("cached", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			DecodeMethodEncoding(enc)
+		}
+	})
+	b.Run("legacy", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			decodeMethodTypesLegacy(enc)
+		}
+	})
+}
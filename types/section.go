@@ -1,6 +1,7 @@
 package types
 
 import (
+	"encoding/binary"
 	"strings"
 )
 
@@ -35,6 +36,46 @@ type Section64 struct {
 	Reserve3 uint32
 }
 
+const (
+	Section32Size = 68
+	Section64Size = 80
+)
+
+// Get decodes a 32-bit section header from b
+func (s *Section32) Get(b []byte, o binary.ByteOrder) int {
+	_ = b[Section32Size-1] // bounds check hint to compiler
+	copy(s.Name[:], b[0:16])
+	copy(s.Seg[:], b[16:32])
+	s.Addr = o.Uint32(b[32:])
+	s.Size = o.Uint32(b[36:])
+	s.Offset = o.Uint32(b[40:])
+	s.Align = o.Uint32(b[44:])
+	s.Reloff = o.Uint32(b[48:])
+	s.Nreloc = o.Uint32(b[52:])
+	s.Flags = SectionFlag(o.Uint32(b[56:]))
+	s.Reserve1 = o.Uint32(b[60:])
+	s.Reserve2 = o.Uint32(b[64:])
+	return Section32Size
+}
+
+// Get decodes a 64-bit section header from b
+func (s *Section64) Get(b []byte, o binary.ByteOrder) int {
+	_ = b[Section64Size-1] // bounds check hint to compiler
+	copy(s.Name[:], b[0:16])
+	copy(s.Seg[:], b[16:32])
+	s.Addr = o.Uint64(b[32:])
+	s.Size = o.Uint64(b[40:])
+	s.Offset = o.Uint32(b[48:])
+	s.Align = o.Uint32(b[52:])
+	s.Reloff = o.Uint32(b[56:])
+	s.Nreloc = o.Uint32(b[60:])
+	s.Flags = SectionFlag(o.Uint32(b[64:]))
+	s.Reserve1 = o.Uint32(b[68:])
+	s.Reserve2 = o.Uint32(b[72:])
+	s.Reserve3 = o.Uint32(b[76:])
+	return Section64Size
+}
+
 type SectionFlag uint32
 
 const (